@@ -0,0 +1,308 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Benchmark of the solver engines over the corpora of puzzles in bench/corpora.  For each
+/// corpus and engine the puzzles are solved one at a time, repeat times over (20 by default), and
+/// the puzzles per second, the median and 99th percentile time of a puzzle, and the guesses per
+/// puzzle are written as JSON.  A guess is a value tried where there was more than one to choose
+/// from, so the engines' counts can be compared.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "src/DancingLinks.h"
+#include "src/PuzzleFile.h"
+#include "src/SudokuBitBoard.h"
+#include "src/SudokuBoard.h"
+
+namespace
+{
+
+// A puzzle, the values row by row.
+struct Puzzle
+{
+  short values[sudoku::SudokuTables::numberOfGridPoints];
+};
+
+// The results of solving a corpus with an engine.
+struct Result
+{
+  std::string corpus; // The name of the corpus.
+  std::string engine; // The name of the engine.
+  std::size_t solves; // The number of puzzles solved, counting each repeat.
+  std::size_t solved; // The number of those that had a solution.
+  double seconds; // The total time.
+  std::vector<double> microseconds; // The time of each solve.
+  unsigned long guesses; // The total guesses of the searches.
+};
+
+// The corpora, each read from bench/corpora/<name>.txt.
+const char* const corpora[] = { "easy", "hard", "17-clue", "pathological" };
+
+// The engines.
+const char* const engines[] = { "bitboard", "dancinglinks", "backtracking" };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Reads a corpus, one puzzle of 81 digits or dots to a line.  Empty lines and lines
+/// starting with '#' are skipped.
+/// \param path The path of the corpus.
+/// \return The puzzles.
+/// \throws runtime_error If the file cannot be read or a line is not a puzzle.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::vector<Puzzle> readCorpus( const std::string& path )
+{
+  sudoku::PuzzleFile file(path);
+  std::vector<Puzzle> puzzles;
+  const char* line;
+  std::size_t length;
+
+  for ( std::size_t number(1); file.nextLine(line, length); ++number )
+  {
+    if ( length == 0 || line[0] == '#' )
+    {
+      continue;
+    }
+
+    Puzzle puzzle;
+    if ( length != sudoku::SudokuTables::numberOfGridPoints ||
+         ! sudoku::PuzzleFile::decode(line, puzzle.values) )
+    {
+      throw std::runtime_error("Line " + std::to_string(number) + " of " + path +
+        " is not a puzzle.");
+    }
+    puzzles.push_back(puzzle);
+  }
+
+  return puzzles;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Solves a puzzle with an engine.
+/// \param engine The engine.
+/// \param puzzle The puzzle.
+/// \param guesses Set to the number of guesses of the search.
+/// \return true if a solution was found, false otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool solve( const std::string& engine, const Puzzle& puzzle, unsigned long& guesses )
+{
+  // The solvers are big, so they are made once and reused as a caller would.
+  static sudoku::SudokuBitBoard bitBoard;
+  static sudoku::DancingLinks dancingLinks;
+  short solution[sudoku::SudokuTables::numberOfGridPoints];
+
+  if ( engine == "bitboard" )
+  {
+    const bool found(bitBoard.solve(puzzle.values, solution));
+    guesses = bitBoard.getGuesses();
+    return found;
+  }
+  if ( engine == "dancinglinks" )
+  {
+    const bool found(dancingLinks.solve(puzzle.values, solution));
+    guesses = dancingLinks.getGuesses();
+    return found;
+  }
+
+  sudoku::SudokuBoard board(puzzle.values);
+  const bool found(board.searchBoard() == sudoku::SudokuBoard::SearchState::Solved);
+  guesses = board.getSearchGuesses();
+  return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Solves every puzzle of a corpus with an engine, repeat times over.
+/// \param corpus The name of the corpus.
+/// \param puzzles The puzzles.
+/// \param engine The engine.
+/// \param repeat The number of times to solve each puzzle.
+/// \return The results.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Result run( const std::string& corpus, const std::vector<Puzzle>& puzzles,
+  const std::string& engine, unsigned int repeat )
+{
+  Result result = { corpus, engine, 0, 0, 0.0, std::vector<double>(), 0 };
+  result.microseconds.reserve(puzzles.size() * repeat);
+
+  for ( unsigned int pass(0); pass < repeat; ++pass )
+  {
+    for ( const auto& puzzle : puzzles )
+    {
+      unsigned long guesses(0);
+      const auto start(std::chrono::steady_clock::now());
+      const bool found(solve(engine, puzzle, guesses));
+      const std::chrono::duration<double, std::micro> time(
+        std::chrono::steady_clock::now() - start);
+
+      ++result.solves;
+      result.solved += found ? 1 : 0;
+      result.seconds += time.count() / 1e6;
+      result.microseconds.push_back(time.count());
+      result.guesses += guesses;
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets a percentile of some times, the nearest value at or above it.
+/// \param sorted The times, sorted.
+/// \param percentile The percentile, 0 to 100.
+/// \return The time, 0 if there are none.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+double getPercentile( const std::vector<double>& sorted, double percentile )
+{
+  if ( sorted.empty() )
+  {
+    return 0.0;
+  }
+
+  std::size_t rank(static_cast<std::size_t>(percentile / 100.0 * sorted.size() + 0.5));
+  return sorted[std::min(sorted.size() - 1, rank == 0 ? 0 : rank - 1)];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Writes the results as JSON.
+/// \param results The results, their times are sorted.
+/// \param repeat The number of times each puzzle was solved.
+/// \param output The stream to write to.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void writeJson( std::vector<Result>& results, unsigned int repeat, std::ostream& output )
+{
+  output << std::fixed << std::setprecision(3);
+  output << "{\n  \"repeat\": " << repeat << ",\n  \"results\": [";
+
+  for ( std::size_t i(0); i < results.size(); ++i )
+  {
+    Result& result(results[i]);
+    std::sort(result.microseconds.begin(), result.microseconds.end());
+    const double solves(static_cast<double>(std::max<std::size_t>(result.solves, 1)));
+
+    output << ( i == 0 ? "" : "," ) << "\n    {"
+      << "\"corpus\": \"" << result.corpus << "\", "
+      << "\"engine\": \"" << result.engine << "\", "
+      << "\"puzzles\": " << result.solves / repeat << ", "
+      << "\"solved\": " << result.solved / repeat << ", "
+      << "\"puzzlesPerSecond\": " << ( result.seconds > 0.0 ? result.solves / result.seconds : 0.0 )
+      << ", \"medianMicroseconds\": " << getPercentile(result.microseconds, 50.0) << ", "
+      << "\"p99Microseconds\": " << getPercentile(result.microseconds, 99.0) << ", "
+      << "\"guessesPerPuzzle\": " << result.guesses / solves << "}";
+  }
+
+  output << "\n  ]\n}\n";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Splits a comma separated list.
+/// \param list The list.
+/// \return The items.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::vector<std::string> split( const std::string& list )
+{
+  std::vector<std::string> items;
+  std::istringstream stream(list);
+  std::string item;
+  while ( std::getline(stream, item, ',') )
+  {
+    items.push_back(item);
+  }
+  return items;
+}
+
+} // End of anonymous namespace.
+
+int main(int argc, char* argv[])
+{
+  std::string directory("./bench/corpora");
+  std::vector<std::string> corpusNames(std::begin(corpora), std::end(corpora));
+  std::vector<std::string> engineNames(std::begin(engines), std::end(engines));
+  unsigned int repeat(20);
+  std::string outputPath;
+
+  for ( int i(1); i < argc; ++i )
+  {
+    const std::string option(argv[i]);
+    const bool hasValue(i + 1 < argc);
+    if ( option == "--corpora" && hasValue )
+    {
+      directory = argv[++i];
+    }
+    else if ( option == "--corpus" && hasValue )
+    {
+      corpusNames = split(argv[++i]);
+    }
+    else if ( option == "--engine" && hasValue )
+    {
+      engineNames = split(argv[++i]);
+    }
+    else if ( option == "--repeat" && hasValue )
+    {
+      repeat = std::max(1ul, std::strtoul(argv[++i], 0, 10));
+    }
+    else if ( option == "--output" && hasValue )
+    {
+      outputPath = argv[++i];
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--corpora directory] [--corpus name,...] "
+        "[--engine bitboard|dancinglinks|backtracking,...] [--repeat count] [--output file]"
+        << std::endl;
+      return 1;
+    }
+  }
+
+  for ( const auto& engine : engineNames )
+  {
+    if ( std::find(std::begin(engines), std::end(engines), engine) == std::end(engines) )
+    {
+      std::cerr << "Unknown engine " << engine << std::endl;
+      return 1;
+    }
+  }
+
+  std::vector<Result> results;
+  try
+  {
+    for ( const auto& corpus : corpusNames )
+    {
+      const std::vector<Puzzle> puzzles(readCorpus(directory + "/" + corpus + ".txt"));
+      for ( const auto& engine : engineNames )
+      {
+        results.push_back(run(corpus, puzzles, engine, repeat));
+        std::cerr << corpus << " " << engine << ": " << results.back().seconds << " s"
+          << std::endl;
+      }
+    }
+  }
+  catch ( std::runtime_error &e )
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  if ( outputPath.empty() )
+  {
+    writeJson(results, repeat, std::cout);
+  }
+  else
+  {
+    std::ofstream output(outputPath.c_str());
+    writeJson(results, repeat, output);
+    if ( ! output )
+    {
+      std::cerr << "Cannot write " << outputPath << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
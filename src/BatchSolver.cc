@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of BatchSolver.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "BatchSolver.h"
+
+namespace sudoku
+{
+
+const std::string BatchSolver::noSolution("no solution");
+const std::string BatchSolver::invalidPuzzle("invalid puzzle");
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+BatchSolver::BatchSolver( unsigned int numberOfThreads, std::size_t chunkSize )
+  : pool_(numberOfThreads), chunkSize_(chunkSize != 0 ? chunkSize : 1), solvers_()
+{
+  for ( unsigned int worker(0); worker < pool_.getNumberOfWorkers(); ++worker )
+  {
+    solvers_.emplace_back(new SudokuBitBoard());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t BatchSolver::solve( std::istream& input, std::ostream& output )
+{
+  std::vector<std::string> puzzles;
+  std::vector<std::string> solutions;
+  std::string line;
+  std::size_t numberRead(0);
+
+  puzzles.reserve(chunkSize_);
+
+  while ( input )
+  {
+    puzzles.clear();
+    while ( puzzles.size() < chunkSize_ && std::getline(input, line) )
+    {
+      puzzles.push_back(line);
+    }
+
+    solve(puzzles, solutions);
+    for ( auto &solution : solutions )
+    {
+      output << solution << '\n';
+    }
+    numberRead += puzzles.size();
+  }
+
+  output.flush();
+  return numberRead;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolver::solve( const std::vector<std::string>& puzzles,
+  std::vector<std::string>& solutions )
+{
+  solutions.resize(puzzles.size());
+
+  pool_.run(puzzles.size(),
+    [this, &puzzles, &solutions]( unsigned int worker, std::size_t task )
+    {
+      solutions[task] = solvePuzzle_(*solvers_[worker], puzzles[task].data(),
+        puzzles[task].size());
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t BatchSolver::solve( PuzzleFile& input, std::ostream& output )
+{
+  std::vector<Line_> lines;
+  std::vector<std::string> solutions;
+  Line_ line;
+  std::size_t numberRead(0);
+
+  lines.reserve(chunkSize_);
+
+  do
+  {
+    lines.clear();
+    while ( lines.size() < chunkSize_ && input.nextLine(line.begin, line.length) )
+    {
+      lines.push_back(line);
+    }
+
+    solutions.resize(lines.size());
+    pool_.run(lines.size(),
+      [this, &lines, &solutions]( unsigned int worker, std::size_t task )
+      {
+        solutions[task] = solvePuzzle_(*solvers_[worker], lines[task].begin, lines[task].length);
+      });
+
+    for ( auto &solution : solutions )
+    {
+      output << solution << '\n';
+    }
+    numberRead += lines.size();
+  } while ( lines.size() == chunkSize_ );
+
+  output.flush();
+  return numberRead;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string BatchSolver::solvePuzzle_( SudokuBitBoard& solver, const char* puzzle,
+  std::size_t length )
+{
+  const std::size_t numberOfGridPoints(SudokuTables::numberOfGridPoints);
+
+  // Allow for files with Windows line endings.
+  if ( length > 0 && puzzle[length - 1] == '\r' )
+  {
+    --length;
+  }
+
+  short values[SudokuTables::numberOfGridPoints];
+  short solution[SudokuTables::numberOfGridPoints];
+
+  if ( length != numberOfGridPoints || ! PuzzleFile::decode(puzzle, values) )
+  {
+    return invalidPuzzle;
+  }
+
+  if ( ! solver.solve(values, solution) )
+  {
+    return noSolution;
+  }
+
+  std::string result(numberOfGridPoints, '0');
+  for ( std::size_t i(0); i < numberOfGridPoints; ++i )
+  {
+    result[i] = static_cast<char>('0' + solution[i]);
+  }
+  return result;
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,95 @@
+#ifndef __sudoku_batchsolver_h__
+#define __sudoku_batchsolver_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of BatchSolver.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "PuzzleFile.h"
+#include "SudokuBitBoard.h"
+#include "WorkStealingPool.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief BatchSolver solves many puzzles across a WorkStealingPool.  A puzzle is a line of 81
+/// characters, the values row by row with '0' or '.' for no value, and its solution is written in
+/// the same form.  Each worker has its own SudokuBitBoard, reused for every puzzle it solves.
+/// Puzzles are read and solved a chunk at a time, so memory does not grow with the input, and the
+/// solutions are written in the order the puzzles were read.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class BatchSolver
+{
+  public:
+    static const std::string noSolution; // Written for a puzzle with no solution.
+    static const std::string invalidPuzzle; // Written for a line that is not a puzzle.
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief BatchSolver constructor.
+    /// \param numberOfThreads The number of threads, 0 for one per hardware thread.
+    /// \param chunkSize The number of puzzles read and solved at a time.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit BatchSolver( unsigned int numberOfThreads = 0, std::size_t chunkSize = 65536 );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves every puzzle read from input, writing a line to output for each.
+    /// \param input The puzzles, one per line.
+    /// \param output The solutions, noSolution or invalidPuzzle, one per line.
+    /// \return The number of puzzles read.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t solve( std::istream& input, std::ostream& output );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves puzzles held in memory.
+    /// \param puzzles The puzzles.
+    /// \param solutions Resized to hold the solution, noSolution or invalidPuzzle for each puzzle.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void solve( const std::vector<std::string>& puzzles, std::vector<std::string>& solutions );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves every puzzle in a file, writing a line to output for each.  The puzzles are
+    /// decoded straight from the file's mapping by the workers.
+    /// \param input The puzzles, one per line.
+    /// \param output The solutions, noSolution or invalidPuzzle, one per line.
+    /// \return The number of puzzles read.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t solve( PuzzleFile& input, std::ostream& output );
+
+  /// Private types.
+  private:
+    // Struct holding a line of a PuzzleFile.
+    struct Line_
+    {
+      const char* begin; // The first character.
+      std::size_t length; // The number of characters.
+    };
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves one puzzle.
+    /// \param solver The solver to use.
+    /// \param puzzle The puzzle.
+    /// \param length The number of characters in the puzzle.
+    /// \return The solution, noSolution or invalidPuzzle.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::string solvePuzzle_( SudokuBitBoard& solver, const char* puzzle,
+      std::size_t length );
+
+  /// Private variables.
+  private:
+    WorkStealingPool pool_; // The threads.
+    std::size_t chunkSize_; // The number of puzzles read and solved at a time.
+    std::vector<std::unique_ptr<SudokuBitBoard> > solvers_; // A solver for each worker.
+};
+ 
+} // End of namespace sudoku.
+
+#endif
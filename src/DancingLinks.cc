@@ -0,0 +1,251 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of BasicDancingLinks.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "DancingLinks.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+BasicDancingLinks<BoxSize>::BasicDancingLinks()
+  : nodes_(0), guesses_(0)
+{
+  const int boardSize(Tables::boardSize);
+  const int numberOfGridPoints(Tables::numberOfGridPoints);
+
+  // The column headers and the root are linked in a circle.
+  for ( int i(0); i <= root_; ++i )
+  {
+    left_[i] = ( i == 0 ) ? root_ : i - 1;
+    right_[i] = ( i == root_ ) ? 0 : i + 1;
+    up_[i] = i;
+    down_[i] = i;
+    column_[i] = i;
+    row_[i] = -1;
+    if ( i < numberOfColumns )
+    {
+      size_[i] = 0;
+      covered_[i] = false;
+    }
+  }
+
+  int node(root_ + 1);
+  for ( int row(0); row < numberOfRows; ++row )
+  {
+    const int gridPoint(row / boardSize);
+    const int value(row % boardSize);
+    const short* units(Tables::getUnitsOf(gridPoint));
+
+    // The columns satisfied by giving the grid point the value.
+    const int columns[4] = { gridPoint,
+                             numberOfGridPoints + units[0] * boardSize + value,
+                             numberOfGridPoints + units[1] * boardSize + value,
+                             numberOfGridPoints + units[2] * boardSize + value };
+
+    rowNode_[row] = node;
+    for ( int i(0); i < 4; ++i, ++node )
+    {
+      // Link into the row.
+      left_[node] = ( i == 0 ) ? node + 3 : node - 1;
+      right_[node] = ( i == 3 ) ? node - 3 : node + 1;
+
+      // Link to the bottom of the column.
+      const int column(columns[i]);
+      column_[node] = column;
+      row_[node] = row;
+      up_[node] = up_[column];
+      down_[node] = column;
+      down_[up_[column]] = node;
+      up_[column] = node;
+      ++size_[column];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicDancingLinks<BoxSize>::cover_( int column )
+{
+  covered_[column] = true;
+  right_[left_[column]] = right_[column];
+  left_[right_[column]] = left_[column];
+
+  for ( int i(down_[column]); i != column; i = down_[i] )
+  {
+    for ( int j(right_[i]); j != i; j = right_[j] )
+    {
+      down_[up_[j]] = down_[j];
+      up_[down_[j]] = up_[j];
+      --size_[column_[j]];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicDancingLinks<BoxSize>::uncover_( int column )
+{
+  for ( int i(up_[column]); i != column; i = up_[i] )
+  {
+    for ( int j(left_[i]); j != i; j = left_[j] )
+    {
+      ++size_[column_[j]];
+      down_[up_[j]] = j;
+      up_[down_[j]] = j;
+    }
+  }
+
+  right_[left_[column]] = column;
+  left_[right_[column]] = column;
+  covered_[column] = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+int BasicDancingLinks<BoxSize>::chooseColumn_() const
+{
+  int best(right_[root_]);
+  for ( int column(right_[best]); column != root_ && size_[best] > 1; column = right_[column] )
+  {
+    if ( size_[column] < size_[best] )
+    {
+      best = column;
+    }
+  }
+  return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicDancingLinks<BoxSize>::solve( const short (&values)[Tables::numberOfGridPoints],
+  short (&solution)[Tables::numberOfGridPoints] )
+{
+  const int boardSize(Tables::boardSize);
+
+  // Cover the columns of the given values first.  If a column is already covered two of the given
+  // values clash and there is no solution.
+  int numberOfGivens(0);
+  bool clash(false);
+  for ( int gridPoint(0); gridPoint < Tables::numberOfGridPoints && ! clash; ++gridPoint )
+  {
+    if ( values[gridPoint] != 0 )
+    {
+      const int first(rowNode_[gridPoint * boardSize + values[gridPoint] - 1]);
+      int node(first);
+      do
+      {
+        clash = clash || covered_[column_[node]];
+        node = right_[node];
+      } while ( node != first );
+
+      if ( ! clash )
+      {
+        givens_[numberOfGivens++] = first;
+        node = first;
+        do
+        {
+          cover_(column_[node]);
+          node = right_[node];
+        } while ( node != first );
+      }
+    }
+  }
+
+  // Algorithm X, with an explicit stack of chosen rows.
+  nodes_ = 0;
+  guesses_ = 0;
+  bool found(false);
+  int depth(0);
+  int node(0);
+  bool choose(true);
+  while ( ! clash )
+  {
+    if ( choose )
+    {
+      if ( right_[root_] == root_ )
+      {
+        // Every column is covered.
+        found = true;
+        break;
+      }
+      const int column(chooseColumn_());
+      cover_(column);
+      node = down_[column];
+      choose = false;
+    }
+
+    if ( node == column_[node] )
+    {
+      // Tried every row in the column, go back to the previous choice.
+      uncover_(column_[node]);
+      if ( depth == 0 )
+      {
+        break;
+      }
+      node = stack_[--depth];
+      for ( int j(left_[node]); j != node; j = left_[j] )
+      {
+        uncover_(column_[j]);
+      }
+      node = down_[node];
+    }
+    else
+    {
+      // Choose this row.  The column is covered, so its size is what it was when it was chosen.
+      ++nodes_;
+      guesses_ += size_[column_[node]] > 1 ? 1 : 0;
+      stack_[depth++] = node;
+      for ( int j(right_[node]); j != node; j = right_[j] )
+      {
+        cover_(column_[j]);
+      }
+      choose = true;
+    }
+  }
+
+  if ( found )
+  {
+    for ( int gridPoint(0); gridPoint < Tables::numberOfGridPoints; ++gridPoint )
+    {
+      solution[gridPoint] = values[gridPoint];
+    }
+    for ( int i(0); i < depth; ++i )
+    {
+      solution[row_[stack_[i]] / boardSize] = row_[stack_[i]] % boardSize + 1;
+    }
+  }
+
+  // Put the matrix back how it was, in the reverse order it was changed.
+  while ( depth > 0 )
+  {
+    node = stack_[--depth];
+    for ( int j(left_[node]); j != node; j = left_[j] )
+    {
+      uncover_(column_[j]);
+    }
+    uncover_(column_[node]);
+  }
+  while ( numberOfGivens > 0 )
+  {
+    const int first(givens_[--numberOfGivens]);
+    node = left_[first];
+    do
+    {
+      uncover_(column_[node]);
+      node = left_[node];
+    } while ( node != left_[first] );
+  }
+
+  return found;
+}
+
+// The sizes of board that are supported.
+template class BasicDancingLinks<2>;
+template class BasicDancingLinks<3>;
+template class BasicDancingLinks<4>;
+template class BasicDancingLinks<5>;
+
+} // End of namespace sudoku.
@@ -0,0 +1,113 @@
+#ifndef __sudoku_dancinglinks_h__
+#define __sudoku_dancinglinks_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of BasicDancingLinks.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief BasicDancingLinks solves a Sudoku board as an exact cover problem using Knuth's Algorithm
+/// X with dancing links.  The matrix has a row for each (grid point, value) pair and a column for
+/// each grid point, and for each value in each row, column and box (324 columns for 9x9).  All of
+/// the nodes are allocated when the object is constructed, solving only relinks them, so an object
+/// should be reused for many boards.
+/// \tparam BoxSize The size of a box, i.e. 3 for a 9x9 board.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+class BasicDancingLinks
+{
+  public:
+    typedef BasicSudokuTables<BoxSize> Tables; // Tables for the size of board.
+    static const int numberOfColumns = 4 * Tables::numberOfGridPoints; // Constraints.
+    static const int numberOfRows = Tables::numberOfGridPoints * Tables::boardSize;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief BasicDancingLinks constructor, builds the full exact cover matrix.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    BasicDancingLinks();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves a Sudoku board.  The matrix is returned to its original state afterwards.
+    /// \param values The values of the grid points row by row, 0 if the grid point has no value.
+    /// \param solution Filled with the solution row by row, if there is one.
+    /// \return true if a solution was found, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool solve( const short (&values)[Tables::numberOfGridPoints],
+      short (&solution)[Tables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of rows chosen by the last call to solve, i.e. the number of nodes of
+    /// the search tree visited.
+    /// \return The number of nodes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getNodes() const
+    {
+      return nodes_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of rows chosen by the last call to solve from a column with more
+    /// than one row, i.e. the values guessed rather than forced, as counted by the other engines.
+    /// \return The number of guesses.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getGuesses() const
+    {
+      return guesses_;
+    }
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Removes a column from the header list and all rows in the column from the other
+    /// columns they are in.
+    /// \param column The column header node.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void cover_( int column );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reverses cover_.
+    /// \param column The column header node.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void uncover_( int column );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the uncovered column with the fewest rows.
+    /// \return The column header node.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    int chooseColumn_() const;
+
+  /// Private variables.
+  private:
+    static const int root_ = numberOfColumns; // The root node, the column headers come before it.
+    static const int numberOfNodes_ = numberOfColumns + 1 + 4 * numberOfRows; // Size of the pool.
+
+    // The node pool.  Each node is linked to its neighbours in its row (left, right) and column
+    // (up, down).
+    int left_[numberOfNodes_];
+    int right_[numberOfNodes_];
+    int up_[numberOfNodes_];
+    int down_[numberOfNodes_];
+    int column_[numberOfNodes_]; // The column header of each node.
+    int row_[numberOfNodes_]; // The matrix row of each node, i.e. grid point * 9 + value - 1.
+    int size_[numberOfColumns]; // The number of rows in each column.
+    bool covered_[numberOfColumns]; // Whether each column is covered.
+
+    int rowNode_[numberOfRows]; // First node of each matrix row.
+    int stack_[Tables::numberOfGridPoints]; // Rows chosen by the search.
+    int givens_[Tables::numberOfGridPoints]; // Rows for values given on the board.
+    unsigned long nodes_; // Number of rows chosen by the last solve.
+    unsigned long guesses_; // Number of those rows chosen from a column with other rows.
+};
+
+// DancingLinks for the standard 9x9 board.
+typedef BasicDancingLinks<3> DancingLinks;
+ 
+} // End of namespace sudoku.
+
+#endif
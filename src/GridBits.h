@@ -0,0 +1,173 @@
+#ifndef __sudoku_gridbits_h__
+#define __sudoku_gridbits_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of GridBits and the operations on it.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief GridBits holds one bit for each grid point of a 9x9 board, bit i for grid point i
+/// (numbered row by row).  With SSE2 the 81 bits are held in one 128-bit register, otherwise in
+/// two 64-bit integers, the operations below hide which.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct GridBits
+{
+#if defined(__SSE2__)
+  __m128i bits; // Grid points 0 to 63 in the low 64 bits, 64 to 80 in the high 64 bits.
+#else
+  std::uint64_t low; // Grid points 0 to 63.
+  std::uint64_t high; // Grid points 64 to 80.
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Makes GridBits from its low and high 64 bits.
+/// \param low Bits for grid points 0 to 63.
+/// \param high Bits for grid points 64 to 80.
+/// \return The GridBits.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline GridBits makeGridBits(const std::uint64_t low, const std::uint64_t high)
+{
+#if defined(__SSE2__)
+  return GridBits { _mm_set_epi64x(static_cast<long long>(high), static_cast<long long>(low)) };
+#else
+  return GridBits { low, high };
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the low 64 bits.
+/// \param a The GridBits.
+/// \return Bits for grid points 0 to 63.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t lowBits(const GridBits& a)
+{
+#if defined(__SSE2__)
+  return static_cast<std::uint64_t>(_mm_cvtsi128_si64(a.bits));
+#else
+  return a.low;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the high 64 bits.
+/// \param a The GridBits.
+/// \return Bits for grid points 64 to 80.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline std::uint64_t highBits(const GridBits& a)
+{
+#if defined(__SSE2__)
+  return static_cast<std::uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(a.bits, a.bits)));
+#else
+  return a.high;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Bitwise and.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline GridBits operator&(const GridBits& a, const GridBits& b)
+{
+#if defined(__SSE2__)
+  return GridBits { _mm_and_si128(a.bits, b.bits) };
+#else
+  return GridBits { a.low & b.low, a.high & b.high };
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Bitwise or.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline GridBits operator|(const GridBits& a, const GridBits& b)
+{
+#if defined(__SSE2__)
+  return GridBits { _mm_or_si128(a.bits, b.bits) };
+#else
+  return GridBits { a.low | b.low, a.high | b.high };
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Bitwise and not.
+/// \return The bits in a that are not in b.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline GridBits andNot(const GridBits& a, const GridBits& b)
+{
+#if defined(__SSE2__)
+  return GridBits { _mm_andnot_si128(b.bits, a.bits) };
+#else
+  return GridBits { a.low & ~b.low, a.high & ~b.high };
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks if no bits are set.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline bool isEmpty(const GridBits& a)
+{
+#if defined(__SSE2__)
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(a.bits, _mm_setzero_si128())) == 0xFFFF;
+#else
+  return ( a.low | a.high ) == 0;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks if two GridBits have the same bits set.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline bool operator==(const GridBits& a, const GridBits& b)
+{
+#if defined(__SSE2__)
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(a.bits, b.bits)) == 0xFFFF;
+#else
+  return a.low == b.low && a.high == b.high;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks if the bit for a grid point is set.
+/// \param a The GridBits.
+/// \param gridPoint The grid point (0 to 80).
+/// \return true if the bit is set, false otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline bool hasGridPoint(const GridBits& a, const short gridPoint)
+{
+  return gridPoint < 64 ? ( ( lowBits(a) >> gridPoint ) & 1 ) != 0 :
+    ( ( highBits(a) >> ( gridPoint - 64 ) ) & 1 ) != 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks if exactly one bit is set.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline bool hasOneBit(const GridBits& a)
+{
+  const std::uint64_t low(lowBits(a));
+  const std::uint64_t high(highBits(a));
+  return low != 0 ? high == 0 && ( low & ( low - 1 ) ) == 0 :
+    high != 0 && ( high & ( high - 1 ) ) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the lowest grid point with its bit set.
+/// \param a The GridBits, must not be empty.
+/// \return The grid point.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline short lowestGridPoint(const GridBits& a)
+{
+  const std::uint64_t low(lowBits(a));
+  return static_cast<short>(low != 0 ? __builtin_ctzll(low) : 64 + __builtin_ctzll(highBits(a)));
+}
+
+} // End of namespace sudoku.
+
+#endif
@@ -1,5 +1,16 @@
+#include "BatchSolver.h"
+#include "PackedPuzzleWriter.h"
+#include "PuzzleFile.h"
+#include "SudokuAssist.h"
+#include "SudokuGenerator.h"
 #include "SudokuBoard.h"
 #include "SudokuGridPoint.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 // The Al Escargot.
@@ -16,8 +27,158 @@ const short alEscargot[9][9] =
 {0, 0, 7, 0, 0, 0, 3, 0, 0}
 };
 
-int main(void)
+int main(int argc, char* argv[])
 {
+  // Batch mode, solve the puzzles in a file or on stdin, one per line, and write the solutions to
+  // stdout.
+  if ( argc >= 2 && std::string(argv[1]) == "--batch" )
+  {
+    if ( argc > 4 )
+    {
+      std::cerr << "Usage: " << argv[0] << " --batch [threads [puzzles]] [< puzzles] > solutions"
+        << std::endl;
+      return 1;
+    }
+
+    std::ios_base::sync_with_stdio(false);
+    sudoku::BatchSolver batchSolver(argc >= 3 ? std::strtoul(argv[2], 0, 10) : 0);
+    if ( argc == 4 )
+    {
+      try
+      {
+        sudoku::PuzzleFile puzzles(argv[3]);
+        batchSolver.solve(puzzles, std::cout);
+      }
+      catch ( std::runtime_error &e )
+      {
+        std::cerr << e.what() << std::endl;
+        return 1;
+      }
+    }
+    else
+    {
+      batchSolver.solve(std::cin, std::cout);
+    }
+    return 0;
+  }
+
+  // Generate mode, write count puzzles with exactly one solution to stdout, one per line.
+  if ( argc >= 3 && std::string(argv[1]) == "--generate" )
+  {
+    const std::string symmetry(argc >= 6 ? argv[5] : "none");
+    if ( argc > 6 || ( symmetry != "none" && symmetry != "rotational" && symmetry != "mirror" &&
+         symmetry != "diagonal" ) )
+    {
+      std::cerr << "Usage: " << argv[0] << " --generate count [clues [seed "
+        "[none|rotational|mirror|diagonal]]] > puzzles" << std::endl;
+      return 1;
+    }
+
+    const std::size_t count(std::strtoul(argv[2], 0, 10));
+    const short clues(argc >= 4 ? static_cast<short>(std::strtol(argv[3], 0, 10)) : 0);
+    const std::uint64_t seed(argc >= 5 ? std::strtoull(argv[4], 0, 10) : 0);
+    sudoku::SudokuGenerator generator(clues,
+      symmetry == "rotational" ? sudoku::SudokuGenerator::Symmetry::Rotational :
+      symmetry == "mirror" ? sudoku::SudokuGenerator::Symmetry::Mirror :
+      symmetry == "diagonal" ? sudoku::SudokuGenerator::Symmetry::Diagonal :
+      sudoku::SudokuGenerator::Symmetry::None);
+
+    // Generate a chunk at a time so memory does not grow with count.
+    std::ios_base::sync_with_stdio(false);
+    const std::size_t chunkSize(65536);
+    std::vector<std::string> puzzles;
+    std::size_t missed(0);
+    for ( std::size_t done(0); done < count; done += chunkSize )
+    {
+      missed += generator.generate(seed, std::min(chunkSize, count - done), puzzles, done);
+      for ( auto &puzzle : puzzles )
+      {
+        std::cout << puzzle << '\n';
+      }
+    }
+    std::cout.flush();
+
+    // Say so if some puzzles could not be brought down to the clues wanted.
+    if ( missed > 0 )
+    {
+      std::cerr << missed << " of " << count << " puzzles have more than " << clues << " clues"
+        << std::endl;
+    }
+    return 0;
+  }
+
+  // Pack mode, convert a file of puzzles in the form read by --batch to a packed file.
+  if ( argc >= 2 && std::string(argv[1]) == "--pack" )
+  {
+    if ( argc != 4 )
+    {
+      std::cerr << "Usage: " << argv[0] << " --pack puzzles packed" << std::endl;
+      return 1;
+    }
+
+    try
+    {
+      sudoku::PuzzleFile puzzles(argv[2]);
+      sudoku::PackedPuzzleWriter writer(argv[3], false);
+      const char* line;
+      std::size_t length;
+      short values[81];
+      while ( puzzles.nextLine(line, length) )
+      {
+        if ( length != 81 || ! sudoku::PuzzleFile::decode(line, values) )
+        {
+          std::cerr << "Puzzle " << writer.getNumberOfPuzzles() + 1 << " is invalid" << std::endl;
+          return 1;
+        }
+        writer.write(values);
+      }
+      writer.close();
+    }
+    catch ( std::runtime_error &e )
+    {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
+  // Rate mode, write each puzzle in a file with the hardest technique needed to solve it.
+  if ( argc >= 2 && std::string(argv[1]) == "--rate" )
+  {
+    if ( argc != 3 )
+    {
+      std::cerr << "Usage: " << argv[0] << " --rate puzzles > ratings" << std::endl;
+      return 1;
+    }
+
+    try
+    {
+      std::ios_base::sync_with_stdio(false);
+      sudoku::PuzzleFile puzzles(argv[2]);
+      sudoku::SudokuAssist assist;
+      const char* line;
+      std::size_t length;
+      short values[81];
+      for ( std::size_t number(1); puzzles.nextLine(line, length); ++number )
+      {
+        if ( length != 81 || ! sudoku::PuzzleFile::decode(line, values) )
+        {
+          std::cerr << "Puzzle " << number << " is invalid" << std::endl;
+          return 1;
+        }
+        std::cout.write(line, length);
+        std::cout << ' ' << sudoku::SudokuAssist::getTechniqueName(assist.rate(values)) << '\n';
+      }
+      std::cout.flush();
+    }
+    catch ( std::runtime_error &e )
+    {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+
   sudoku::SudokuBoard sb(alEscargot);
 
   sb.solveBoard();
@@ -26,13 +187,10 @@ int main(void)
 
   short array[9][9];
 
-//  for (std::vector<sudoku::SudokuGridPoint>::iterator iter(points.begin()); iter != points.end(); iter++)
-//  {
-//    std::cout << "x: " << (*iter).getX() + 1 << ", y: " << (*iter).getY() + 1 << ", value: " << (*iter).getValue() << std::endl;
-//    array[(*iter).getX()][(*iter).getY()] = (*iter).getValue();
-//    std::cout << "Press enter to continue" << std::endl;
-//    std::cin.ignore();
-//  }
+  for ( auto &point : points )
+  {
+    array[point.getX()][point.getY()] = point.getValue();
+  }
 
   std::cout << "\nThe full sudoku board:" << std::endl;
   for ( int i(0); i < 9; ++i )
@@ -0,0 +1,67 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of MappedFile.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedFile.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile( const std::string& path, bool sequential )
+  : data_(nullptr), size_(0)
+{
+  const int file(open(path.c_str(), O_RDONLY));
+  if ( file < 0 )
+  {
+    throw std::runtime_error("Cannot open " + path + ": " + std::strerror(errno));
+  }
+
+  struct stat status;
+  if ( fstat(file, &status) != 0 )
+  {
+    const int error(errno);
+    close(file);
+    throw std::runtime_error("Cannot read the size of " + path + ": " + std::strerror(error));
+  }
+  size_ = static_cast<std::size_t>(status.st_size);
+
+  // An empty file cannot be mapped.
+  if ( size_ > 0 )
+  {
+    void* mapping(mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0));
+    if ( mapping == MAP_FAILED )
+    {
+      const int error(errno);
+      close(file);
+      throw std::runtime_error("Cannot map " + path + ": " + std::strerror(error));
+    }
+
+    (void)madvise(mapping, size_, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    data_ = static_cast<const char*>(mapping);
+  }
+
+  // The mapping stays valid once the file is closed.
+  close(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+  if ( data_ != nullptr )
+  {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,64 @@
+#ifndef __sudoku_mappedfile_h__
+#define __sudoku_mappedfile_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of MappedFile.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief MappedFile maps a whole file read only, so it can be read as memory without copying.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class MappedFile
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief MappedFile constructor, maps the file.
+    /// \param path The path of the file.
+    /// \param sequential Whether the file will be read from start to end, so the kernel can read
+    /// ahead.
+    /// \throws runtime_error If the file cannot be opened or mapped.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    MappedFile( const std::string& path, bool sequential );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief MappedFile destructor, unmaps the file.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ~MappedFile();
+
+    MappedFile( const MappedFile& ) = delete;
+    MappedFile& operator=( const MappedFile& ) = delete;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the contents of the file.
+    /// \return The start of the mapping, null if the file is empty.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    const char* getData() const
+    {
+      return data_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the size of the file.
+    /// \return The size in bytes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t getSize() const
+    {
+      return size_;
+    }
+
+  /// Private variables.
+  private:
+    const char* data_; // The mapped file, null if the file is empty.
+    std::size_t size_; // The size of the file.
+};
+
+} // End of namespace sudoku.
+
+#endif
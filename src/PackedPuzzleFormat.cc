@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of PackedPuzzleFormat.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "PackedPuzzleFormat.h"
+
+namespace
+{
+
+// The magic at the start of a packed file.
+const char magic[4] = { 'S', 'D', 'K', 'P' };
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Builds the table for the CRC-32 of each byte.
+/// \return The table.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const std::uint32_t* makeChecksumTable()
+{
+  static std::uint32_t table[256];
+
+  for ( std::uint32_t byte(0); byte < 256; ++byte )
+  {
+    std::uint32_t crc(byte);
+    for ( short bit(0); bit < 8; ++bit )
+    {
+      crc = ( crc & 1 ) ? ( crc >> 1 ) ^ 0xEDB88320u : crc >> 1;
+    }
+    table[byte] = crc;
+  }
+
+  return table;
+}
+
+} // End of anonymous namespace.
+
+namespace sudoku
+{
+
+const std::uint16_t PackedPuzzleFormat::version;
+const std::uint16_t PackedPuzzleFormat::hasSolutionsFlag;
+const std::size_t PackedPuzzleFormat::headerSize;
+const std::size_t PackedPuzzleFormat::bitmapSize;
+const std::size_t PackedPuzzleFormat::solutionSize;
+const std::size_t PackedPuzzleFormat::maxPuzzleSize;
+const std::size_t PackedPuzzleFormat::indexBlockSize;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormat::writeHeader( const Header& header, char (&bytes)[headerSize] )
+{
+  std::memset(bytes, 0, headerSize);
+  std::memcpy(bytes, magic, sizeof(magic));
+  writeNumber(version, 2, bytes + 4);
+  writeNumber(header.hasSolutions ? hasSolutionsFlag : 0, 2, bytes + 6);
+  writeNumber(header.numberOfPuzzles, 8, bytes + 8);
+  writeNumber(header.indexOffset, 8, bytes + 16);
+  writeNumber(header.checksum, 4, bytes + 24);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool PackedPuzzleFormat::readHeader( const char* bytes, Header& header )
+{
+  if ( std::memcmp(bytes, magic, sizeof(magic)) != 0 || readNumber(bytes + 4, 2) != version )
+  {
+    return false;
+  }
+
+  header.hasSolutions = ( readNumber(bytes + 6, 2) & hasSolutionsFlag ) != 0;
+  header.numberOfPuzzles = readNumber(bytes + 8, 8);
+  header.indexOffset = readNumber(bytes + 16, 8);
+  header.checksum = static_cast<std::uint32_t>(readNumber(bytes + 24, 4));
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t PackedPuzzleFormat::packPuzzle(
+  const short (&values)[SudokuTables::numberOfGridPoints], char* bytes )
+{
+  std::memset(bytes, 0, bitmapSize);
+  std::size_t numberOfValues(0);
+  char* packedValues(bytes + bitmapSize);
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( values[i] < 0 || values[i] > SudokuTables::boardSize )
+    {
+      throw std::invalid_argument("Grid point " + std::to_string(i) + " has value " +
+        std::to_string(values[i]));
+    }
+    if ( values[i] != 0 )
+    {
+      bytes[i / 8] |= static_cast<char>(1 << ( i % 8 ));
+      if ( numberOfValues % 2 == 0 )
+      {
+        packedValues[numberOfValues / 2] = static_cast<char>(values[i]);
+      }
+      else
+      {
+        packedValues[numberOfValues / 2] |= static_cast<char>(values[i] << 4);
+      }
+      ++numberOfValues;
+    }
+  }
+
+  return bitmapSize + ( numberOfValues + 1 ) / 2;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t PackedPuzzleFormat::unpackPuzzle( const char* bytes, std::size_t available,
+  short (&values)[SudokuTables::numberOfGridPoints] )
+{
+  if ( available < bitmapSize )
+  {
+    return 0;
+  }
+
+  std::size_t numberOfValues(0);
+  for ( std::size_t i(0); i < bitmapSize; ++i )
+  {
+    numberOfValues += __builtin_popcount(static_cast<unsigned char>(bytes[i]));
+  }
+  const std::size_t size(bitmapSize + ( numberOfValues + 1 ) / 2);
+  if ( size > available )
+  {
+    return 0;
+  }
+
+  const unsigned char* packedValues(reinterpret_cast<const unsigned char*>(bytes + bitmapSize));
+  std::size_t next(0);
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    values[i] = 0;
+    if ( ( bytes[i / 8] >> ( i % 8 ) ) & 1 )
+    {
+      values[i] = ( packedValues[next / 2] >> ( 4 * ( next % 2 ) ) ) & 0xF;
+      if ( values[i] == 0 || values[i] > SudokuTables::boardSize )
+      {
+        return 0;
+      }
+      ++next;
+    }
+  }
+
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormat::packSolution( const short (&values)[SudokuTables::numberOfGridPoints],
+  char* bytes )
+{
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( values[i] < 1 || values[i] > SudokuTables::boardSize )
+    {
+      throw std::invalid_argument("Grid point " + std::to_string(i) +
+        " of the solution has value " + std::to_string(values[i]));
+    }
+  }
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; i += 2 )
+  {
+    const short high(i + 1 < SudokuTables::numberOfGridPoints ? values[i + 1] : 0);
+    bytes[i / 2] = static_cast<char>(values[i] | ( high << 4 ));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool PackedPuzzleFormat::unpackSolution( const char* bytes,
+  short (&values)[SudokuTables::numberOfGridPoints] )
+{
+  const unsigned char* packedValues(reinterpret_cast<const unsigned char*>(bytes));
+  bool valid(true);
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    values[i] = ( packedValues[i / 2] >> ( 4 * ( i % 2 ) ) ) & 0xF;
+    valid = valid && values[i] != 0 && values[i] <= SudokuTables::boardSize;
+  }
+
+  return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::uint32_t PackedPuzzleFormat::updateChecksum( std::uint32_t checksum, const char* bytes,
+  std::size_t size )
+{
+  static const std::uint32_t* const table(makeChecksumTable()); // CRC-32 of each byte.
+  std::uint32_t crc(~checksum);
+
+  for ( std::size_t i(0); i < size; ++i )
+  {
+    crc = table[( crc ^ static_cast<unsigned char>(bytes[i]) ) & 0xFF] ^ ( crc >> 8 );
+  }
+
+  return ~crc;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormat::writeNumber( std::uint64_t value, std::size_t size, char* bytes )
+{
+  for ( std::size_t i(0); i < size; ++i )
+  {
+    bytes[i] = static_cast<char>(( value >> ( 8 * i ) ) & 0xFF);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::uint64_t PackedPuzzleFormat::readNumber( const char* bytes, std::size_t size )
+{
+  std::uint64_t value(0);
+
+  for ( std::size_t i(0); i < size; ++i )
+  {
+    value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << ( 8 * i );
+  }
+
+  return value;
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,139 @@
+#ifndef __sudoku_packedpuzzleformat_h__
+#define __sudoku_packedpuzzleformat_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of PackedPuzzleFormat.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+
+#include "SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PackedPuzzleFormat describes the packed file of 9x9 puzzles written by
+/// PackedPuzzleWriter and read by PackedPuzzleReader.  All numbers are little endian.  The file is:
+///
+///   The header, headerSize bytes: the magic "SDKP", the version (2 bytes), the flags (2 bytes,
+///   hasSolutionsFlag if each puzzle has its solution), the number of puzzles (8 bytes), the
+///   offset of the index (8 bytes), the checksum (4 bytes) and 4 bytes of 0.
+///
+///   The records, one per puzzle.  A puzzle is a bitmap of the grid points with values
+///   (bitmapSize bytes, bit i % 8 of byte i / 8 for grid point i), then those values in order,
+///   two to a byte with the first in the low 4 bits.  If the file has solutions, the solution
+///   follows as the 81 values, two to a byte (solutionSize bytes).
+///
+///   The index.  The offset in the file of every indexBlockSize'th record (8 bytes each), then
+///   the offset of each record from the start of its block (2 bytes each), so finding a record
+///   is two reads.
+///
+/// The checksum is the CRC-32 of everything after the header.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PackedPuzzleFormat
+{
+  public:
+    // Struct holding the header of a packed file.
+    struct Header
+    {
+      bool hasSolutions; // Whether each puzzle has its solution.
+      std::uint64_t numberOfPuzzles; // The number of puzzles.
+      std::uint64_t indexOffset; // The offset of the index in the file.
+      std::uint32_t checksum; // The CRC-32 of everything after the header.
+    };
+
+    static const std::uint16_t version = 1; // The version written.
+    static const std::uint16_t hasSolutionsFlag = 1; // Flag set if the file has solutions.
+    static const std::size_t headerSize = 32; // Bytes in the header.
+    static const std::size_t bitmapSize = 11; // Bytes in the bitmap of a puzzle.
+    static const std::size_t solutionSize = 41; // Bytes in a solution.
+    static const std::size_t maxPuzzleSize = bitmapSize + solutionSize; // Most bytes in a puzzle.
+    static const std::size_t indexBlockSize = 256; // Records in a block of the index.
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes a header.
+    /// \param header The header.
+    /// \param bytes Filled with the header as written to the file.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void writeHeader( const Header& header, char (&bytes)[headerSize] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reads a header.
+    /// \param bytes The header as written to the file.
+    /// \param header Filled with the header.
+    /// \return false if the bytes are not a header of this version, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static bool readHeader( const char* bytes, Header& header );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Packs a puzzle.
+    /// \param values The values row by row, 0 if the grid point has no value.
+    /// \param bytes Filled with the packed puzzle, room for maxPuzzleSize bytes.
+    /// \return The number of bytes written.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::size_t packPuzzle( const short (&values)[SudokuTables::numberOfGridPoints],
+      char* bytes );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Unpacks a puzzle.
+    /// \param bytes The packed puzzle.
+    /// \param available The number of bytes that can be read.
+    /// \param values Filled with the values row by row, 0 if the grid point has no value.
+    /// \return The number of bytes read, 0 if the puzzle runs past available or has a value
+    /// outside the range 1 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::size_t unpackPuzzle( const char* bytes, std::size_t available,
+      short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Packs a solution.
+    /// \param values The values row by row.
+    /// \param bytes Filled with the packed solution, solutionSize bytes.
+    /// \throws invalid_argument If a value is outside the range 1 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void packSolution( const short (&values)[SudokuTables::numberOfGridPoints],
+      char* bytes );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Unpacks a solution.
+    /// \param bytes The packed solution, solutionSize bytes.
+    /// \param values Filled with the values row by row.
+    /// \return false if a value is outside the range 1 to 9, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static bool unpackSolution( const char* bytes,
+      short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Adds bytes to a CRC-32 checksum.
+    /// \param checksum The checksum of the bytes before, 0 to start.
+    /// \param bytes The bytes.
+    /// \param size The number of bytes.
+    /// \return The checksum including the bytes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::uint32_t updateChecksum( std::uint32_t checksum, const char* bytes,
+      std::size_t size );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes a little endian number.
+    /// \param value The number.
+    /// \param size The number of bytes to write.
+    /// \param bytes Filled with the number.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void writeNumber( std::uint64_t value, std::size_t size, char* bytes );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reads a little endian number.
+    /// \param bytes The number.
+    /// \param size The number of bytes to read.
+    /// \return The number.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::uint64_t readNumber( const char* bytes, std::size_t size );
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of PackedPuzzleReader.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+#include "PackedPuzzleReader.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+PackedPuzzleReader::PackedPuzzleReader( const std::string& path, bool verifyChecksum )
+  : path_(path), file_(path, false), header_(), blockOffsets_(nullptr), relativeOffsets_(nullptr)
+{
+  const char* data(file_.getData());
+  const std::size_t size(file_.getSize());
+
+  if ( size < PackedPuzzleFormat::headerSize || ! PackedPuzzleFormat::readHeader(data, header_) )
+  {
+    throw std::runtime_error(path + " is not a packed puzzle file.");
+  }
+
+  // The index must fill the file after the records.
+  const std::uint64_t numberOfBlocks(( header_.numberOfPuzzles +
+    PackedPuzzleFormat::indexBlockSize - 1 ) / PackedPuzzleFormat::indexBlockSize);
+  if ( header_.indexOffset < PackedPuzzleFormat::headerSize || header_.indexOffset > size ||
+       header_.numberOfPuzzles > size || numberOfBlocks * 8 + header_.numberOfPuzzles * 2 !=
+       size - header_.indexOffset )
+  {
+    throw std::runtime_error(path + " has a corrupt header.");
+  }
+
+  if ( verifyChecksum && PackedPuzzleFormat::updateChecksum(0, data +
+       PackedPuzzleFormat::headerSize, size - PackedPuzzleFormat::headerSize) != header_.checksum )
+  {
+    throw std::runtime_error(path + " does not match its checksum.");
+  }
+
+  blockOffsets_ = data + header_.indexOffset;
+  relativeOffsets_ = blockOffsets_ + numberOfBlocks * 8;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReader::readPuzzle( std::uint64_t number,
+  short (&puzzle)[SudokuTables::numberOfGridPoints] ) const
+{
+  std::size_t available;
+  const char* record(findRecord_(number, available));
+
+  if ( PackedPuzzleFormat::unpackPuzzle(record, available, puzzle) == 0 )
+  {
+    throw std::runtime_error("Puzzle " + std::to_string(number) + " in " + path_ +
+      " is corrupt.");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReader::readSolution( std::uint64_t number,
+  short (&solution)[SudokuTables::numberOfGridPoints] ) const
+{
+  if ( ! header_.hasSolutions )
+  {
+    throw std::logic_error(path_ + " does not have solutions.");
+  }
+
+  std::size_t available;
+  const char* record(findRecord_(number, available));
+
+  // The solution follows the puzzle.
+  const std::size_t puzzleSize(PackedPuzzleFormat::unpackPuzzle(record, available, solution));
+  if ( puzzleSize == 0 || available - puzzleSize < PackedPuzzleFormat::solutionSize ||
+       ! PackedPuzzleFormat::unpackSolution(record + puzzleSize, solution) )
+  {
+    throw std::runtime_error("Puzzle " + std::to_string(number) + " in " + path_ +
+      " is corrupt.");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuBoard PackedPuzzleReader::readBoard( std::uint64_t number ) const
+{
+  short puzzle[SudokuTables::numberOfGridPoints];
+  readPuzzle(number, puzzle);
+  return SudokuBoard(puzzle);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const char* PackedPuzzleReader::findRecord_( std::uint64_t number, std::size_t& available ) const
+{
+  if ( number >= header_.numberOfPuzzles )
+  {
+    throw std::out_of_range("No puzzle " + std::to_string(number) + " in " + path_ + ".");
+  }
+
+  const std::uint64_t offset(
+    PackedPuzzleFormat::readNumber(blockOffsets_ + number / PackedPuzzleFormat::indexBlockSize * 8,
+      8) + PackedPuzzleFormat::readNumber(relativeOffsets_ + number * 2, 2));
+  if ( offset < PackedPuzzleFormat::headerSize || offset >= header_.indexOffset )
+  {
+    throw std::runtime_error("The index of " + path_ + " is corrupt.");
+  }
+
+  available = header_.indexOffset - offset;
+  return file_.getData() + offset;
+}
+
+} // End of namespace sudoku.
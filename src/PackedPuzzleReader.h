@@ -0,0 +1,106 @@
+#ifndef __sudoku_packedpuzzlereader_h__
+#define __sudoku_packedpuzzlereader_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of PackedPuzzleReader.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+
+#include "MappedFile.h"
+#include "PackedPuzzleFormat.h"
+#include "SudokuBoard.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PackedPuzzleReader reads puzzles, and their solutions if it has them, from a packed file
+/// as described by PackedPuzzleFormat.  The file is memory mapped and any puzzle can be read
+/// directly using the index.  Reading is const, so several threads can share a reader.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PackedPuzzleReader
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief PackedPuzzleReader constructor, maps the file and checks the header and index.
+    /// \param path The path of the file.
+    /// \param verifyChecksum Whether to check the checksum, which reads the whole file.
+    /// \throws runtime_error If the file cannot be mapped, is not a packed file, or is corrupt.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit PackedPuzzleReader( const std::string& path, bool verifyChecksum = true );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of puzzles in the file.
+    /// \return The number of puzzles.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t getNumberOfPuzzles() const
+    {
+      return header_.numberOfPuzzles;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Returns if the file has the solution of each puzzle.
+    /// \return true if the file has solutions, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool hasSolutions() const
+    {
+      return header_.hasSolutions;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reads a puzzle.
+    /// \param number The number of the puzzle, 0 is the first.
+    /// \param puzzle Filled with the values row by row, 0 if the grid point has no value.
+    /// \throws out_of_range If there is no puzzle with that number.
+    /// \throws runtime_error If the record is corrupt.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void readPuzzle( std::uint64_t number,
+      short (&puzzle)[SudokuTables::numberOfGridPoints] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reads the solution of a puzzle.
+    /// \param number The number of the puzzle, 0 is the first.
+    /// \param solution Filled with the solution row by row.
+    /// \throws out_of_range If there is no puzzle with that number.
+    /// \throws logic_error If the file does not have solutions.
+    /// \throws runtime_error If the record is corrupt.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void readSolution( std::uint64_t number,
+      short (&solution)[SudokuTables::numberOfGridPoints] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Reads a puzzle into a new board.
+    /// \param number The number of the puzzle, 0 is the first.
+    /// \return The board.
+    /// \throws out_of_range If there is no puzzle with that number.
+    /// \throws runtime_error If the record is corrupt.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuBoard readBoard( std::uint64_t number ) const;
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds a record using the index.
+    /// \param number The number of the puzzle.
+    /// \param available Set to the number of bytes from the record to the index.
+    /// \return The start of the record.
+    /// \throws out_of_range If there is no puzzle with that number.
+    /// \throws runtime_error If the index points outside the records.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    const char* findRecord_( std::uint64_t number, std::size_t& available ) const;
+
+  /// Private variables.
+  private:
+    std::string path_; // The path of the file, for errors.
+    MappedFile file_; // The mapped file.
+    PackedPuzzleFormat::Header header_; // The header.
+    const char* blockOffsets_; // The offset of every indexBlockSize'th record.
+    const char* relativeOffsets_; // The offset of each record in its block.
+};
+
+} // End of namespace sudoku.
+
+#endif
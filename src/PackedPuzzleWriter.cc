@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of PackedPuzzleWriter.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+#include "PackedPuzzleWriter.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+PackedPuzzleWriter::PackedPuzzleWriter( const std::string& path, bool hasSolutions )
+  : path_(path), file_(path.c_str(), std::ios::binary | std::ios::trunc), closed_(false),
+    header_(), offset_(PackedPuzzleFormat::headerSize), blockOffsets_(), relativeOffsets_()
+{
+  if ( ! file_ )
+  {
+    throw std::runtime_error("Cannot create " + path);
+  }
+
+  header_.hasSolutions = hasSolutions;
+
+  // Leave room for the header, which is written by close.
+  const char header[PackedPuzzleFormat::headerSize] = { 0 };
+  file_.write(header, PackedPuzzleFormat::headerSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+PackedPuzzleWriter::~PackedPuzzleWriter()
+{
+  if ( ! closed_ )
+  {
+    try
+    {
+      close();
+    }
+    catch ( std::runtime_error& )
+    {
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::write( const short (&puzzle)[SudokuTables::numberOfGridPoints] )
+{
+  char bytes[PackedPuzzleFormat::maxPuzzleSize];
+  const std::size_t size(PackedPuzzleFormat::packPuzzle(puzzle, bytes));
+
+  startRecord_(false);
+  writeBytes_(bytes, size);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::write( const short (&puzzle)[SudokuTables::numberOfGridPoints],
+  const short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  char bytes[PackedPuzzleFormat::maxPuzzleSize + PackedPuzzleFormat::solutionSize];
+  const std::size_t size(PackedPuzzleFormat::packPuzzle(puzzle, bytes));
+  PackedPuzzleFormat::packSolution(solution, bytes + size);
+
+  startRecord_(true);
+  writeBytes_(bytes, size + PackedPuzzleFormat::solutionSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::write( const SudokuBoard& board )
+{
+  short values[SudokuTables::numberOfGridPoints];
+  board.getValues(values);
+  write(values);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::close()
+{
+  if ( closed_ )
+  {
+    return;
+  }
+  closed_ = true;
+
+  header_.numberOfPuzzles = relativeOffsets_.size();
+  header_.indexOffset = offset_;
+
+  char number[8];
+  for ( auto blockOffset : blockOffsets_ )
+  {
+    PackedPuzzleFormat::writeNumber(blockOffset, 8, number);
+    writeBytes_(number, 8);
+  }
+  for ( auto relativeOffset : relativeOffsets_ )
+  {
+    PackedPuzzleFormat::writeNumber(relativeOffset, 2, number);
+    writeBytes_(number, 2);
+  }
+
+  char header[PackedPuzzleFormat::headerSize];
+  PackedPuzzleFormat::writeHeader(header_, header);
+  file_.seekp(0);
+  file_.write(header, PackedPuzzleFormat::headerSize);
+  file_.close();
+
+  if ( ! file_ )
+  {
+    throw std::runtime_error("Cannot write " + path_);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::startRecord_( bool hasSolution )
+{
+  if ( closed_ )
+  {
+    throw std::logic_error("Cannot write to " + path_ + " after it is closed.");
+  }
+  if ( hasSolution != header_.hasSolutions )
+  {
+    throw std::logic_error(hasSolution ? "The file " + path_ + " does not have solutions." :
+      "The file " + path_ + " needs a solution with each puzzle.");
+  }
+
+  if ( relativeOffsets_.size() % PackedPuzzleFormat::indexBlockSize == 0 )
+  {
+    blockOffsets_.push_back(offset_);
+  }
+  relativeOffsets_.push_back(static_cast<std::uint16_t>(offset_ - blockOffsets_.back()));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleWriter::writeBytes_( const char* bytes, std::size_t size )
+{
+  file_.write(bytes, size);
+  header_.checksum = PackedPuzzleFormat::updateChecksum(header_.checksum, bytes, size);
+  offset_ += size;
+}
+
+} // End of namespace sudoku.
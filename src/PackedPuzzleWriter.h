@@ -0,0 +1,112 @@
+#ifndef __sudoku_packedpuzzlewriter_h__
+#define __sudoku_packedpuzzlewriter_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of PackedPuzzleWriter.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "PackedPuzzleFormat.h"
+#include "SudokuBoard.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PackedPuzzleWriter writes puzzles, and optionally their solutions, to a packed file as
+/// described by PackedPuzzleFormat.  The records are written as they are given, and the index and
+/// header when the writer is closed.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PackedPuzzleWriter
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief PackedPuzzleWriter constructor, creates the file.
+    /// \param path The path of the file.
+    /// \param hasSolutions Whether each puzzle is written with its solution.
+    /// \throws runtime_error If the file cannot be created.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    PackedPuzzleWriter( const std::string& path, bool hasSolutions );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief PackedPuzzleWriter destructor, closes the file if close has not been called.  Errors
+    /// are ignored, call close to see them.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ~PackedPuzzleWriter();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes a puzzle to a file without solutions.
+    /// \param puzzle The values row by row, 0 if the grid point has no value.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    /// \throws logic_error If the file has solutions or is closed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void write( const short (&puzzle)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes a puzzle and its solution to a file with solutions.
+    /// \param puzzle The values row by row, 0 if the grid point has no value.
+    /// \param solution The solution row by row.
+    /// \throws invalid_argument If a value is outside the range 0 to 9, or 1 to 9 in the solution.
+    /// \throws logic_error If the file does not have solutions or is closed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void write( const short (&puzzle)[SudokuTables::numberOfGridPoints],
+      const short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes the current values of a board, as given by SudokuBoard::getValues, to a file
+    /// without solutions.
+    /// \param board The board.
+    /// \throws logic_error If the file has solutions or is closed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void write( const SudokuBoard& board );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes the index and header and closes the file.
+    /// \throws runtime_error If the file could not be written.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of puzzles written.
+    /// \return The number of puzzles.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::uint64_t getNumberOfPuzzles() const
+    {
+      return relativeOffsets_.size();
+    }
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Starts a record, adding it to the index.
+    /// \param hasSolution Whether the record has a solution.
+    /// \throws logic_error If hasSolution does not match the file or the file is closed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void startRecord_( bool hasSolution );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Writes bytes after the header, adding them to the checksum.
+    /// \param bytes The bytes.
+    /// \param size The number of bytes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void writeBytes_( const char* bytes, std::size_t size );
+
+  /// Private variables.
+  private:
+    std::string path_; // The path of the file, for errors.
+    std::ofstream file_; // The file.
+    bool closed_; // Whether close has been called.
+    PackedPuzzleFormat::Header header_; // The header, completed by close.
+    std::uint64_t offset_; // The offset of the next byte written.
+    std::vector<std::uint64_t> blockOffsets_; // The offset of every indexBlockSize'th record.
+    std::vector<std::uint16_t> relativeOffsets_; // The offset of each record in its block.
+};
+
+} // End of namespace sudoku.
+
+#endif
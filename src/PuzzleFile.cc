@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of PuzzleFile.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "PuzzleFile.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+PuzzleFile::PuzzleFile( const std::string& path )
+  : file_(path, true), position_(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool PuzzleFile::nextLine( const char*& line, std::size_t& length )
+{
+  const char* data(file_.getData());
+  const std::size_t size(file_.getSize());
+
+  if ( position_ >= size )
+  {
+    return false;
+  }
+
+  line = data + position_;
+  const char* end(static_cast<const char*>(std::memchr(line, '\n', size - position_)));
+  if ( end == nullptr )
+  {
+    // The last line has no '\n'.
+    end = data + size;
+    position_ = size;
+  }
+  else
+  {
+    position_ = end - data + 1;
+  }
+
+  length = end - line;
+  if ( length > 0 && line[length - 1] == '\r' )
+  {
+    --length;
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool PuzzleFile::decode( const char* line, short (&values)[SudokuTables::numberOfGridPoints] )
+{
+  const short numberOfGridPoints(SudokuTables::numberOfGridPoints);
+  short i(0);
+  bool valid(true);
+
+#if defined(__SSE2__)
+  const __m128i zero(_mm_setzero_si128());
+  const __m128i digitZero(_mm_set1_epi8('0'));
+  const __m128i dot(_mm_set1_epi8('.'));
+  const __m128i nine(_mm_set1_epi8(9));
+  int allValid(0xFFFF);
+
+  for ( ; i + 16 <= numberOfGridPoints; i += 16 )
+  {
+    const __m128i characters(_mm_loadu_si128(reinterpret_cast<const __m128i*>(line + i)));
+
+    // Characters below '0' wrap round to large values, so a digit is one left at most 9.
+    const __m128i digits(_mm_sub_epi8(characters, digitZero));
+    const __m128i isDigit(_mm_cmpeq_epi8(_mm_min_epu8(digits, nine), digits));
+    const __m128i isDot(_mm_cmpeq_epi8(characters, dot));
+    allValid &= _mm_movemask_epi8(_mm_or_si128(isDigit, isDot));
+
+    // Dots become 0, then widen the values to shorts.
+    const __m128i bytes(_mm_and_si128(digits, isDigit));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i + 8), _mm_unpackhi_epi8(bytes, zero));
+  }
+  valid = allValid == 0xFFFF;
+#endif
+
+  for ( ; i < numberOfGridPoints; ++i )
+  {
+    if ( line[i] >= '0' && line[i] <= '9' )
+    {
+      values[i] = static_cast<short>(line[i] - '0');
+    }
+    else if ( line[i] == '.' )
+    {
+      values[i] = 0;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+
+  return valid;
+}
+
+} // End of namespace sudoku.
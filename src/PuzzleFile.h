@@ -0,0 +1,69 @@
+#ifndef __sudoku_puzzlefile_h__
+#define __sudoku_puzzlefile_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of PuzzleFile.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <string>
+
+#include "MappedFile.h"
+#include "SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PuzzleFile reads a file of 9x9 puzzles, one per line, each line 81 characters holding
+/// the values row by row with '0' or '.' for no value.  The file is memory mapped and read a line
+/// at a time, each line is given as a pointer into the mapping, so nothing is copied until a
+/// puzzle is decoded straight into the values taken by the solvers.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PuzzleFile
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief PuzzleFile constructor, maps the file.
+    /// \param path The path of the file.
+    /// \throws runtime_error If the file cannot be opened or mapped.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit PuzzleFile( const std::string& path );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the next line of the file.
+    /// \param line Set to the start of the line, which stays valid while the PuzzleFile exists.
+    /// \param length Set to the length of the line, without the '\n' or "\r\n" ending it.
+    /// \return false if there are no more lines, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool nextLine( const char*& line, std::size_t& length );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the size of the file.
+    /// \return The size in bytes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t getSize() const
+    {
+      return file_.getSize();
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks and decodes a puzzle.  With SSE2 the characters are checked and converted
+    /// sixteen at a time.
+    /// \param line The puzzle, at least 81 characters of which only the first 81 are read.
+    /// \param values Filled with the values row by row, 0 if the grid point has no value.  Not
+    /// meaningful if the puzzle is invalid.
+    /// \return true if every character is a digit or '.', false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static bool decode( const char* line, short (&values)[SudokuTables::numberOfGridPoints] );
+
+  /// Private variables.
+  private:
+    MappedFile file_; // The mapped file.
+    std::size_t position_; // The start of the next line.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,101 @@
+#ifndef __sudoku_searchstatistics_h__
+#define __sudoku_searchstatistics_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SearchStatistics and StatisticsTimer.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SearchStatistics holds the work done by a search.  The counts are only kept if the code
+/// is compiled with SUDOKU_STATISTICS defined (make STATISTICS=1), otherwise enabled is false, the
+/// counting is compiled out and every count stays 0.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SearchStatistics
+{
+#if defined(SUDOKU_STATISTICS)
+  static constexpr bool enabled = true; // Whether the counts are kept.
+#else
+  static constexpr bool enabled = false; // Whether the counts are kept.
+#endif
+
+  unsigned long nodes; // Grid points chosen to guess a value for.
+  unsigned long guesses; // Values guessed.
+  unsigned long backtracks; // Grid points given up on after every guess for them failed.
+  unsigned long propagations; // Values forced by naked and hidden singles.
+  unsigned int maxDepth; // Most guesses on the search stack at once.
+  std::uint64_t populateNanoseconds; // Time spent setting up the board.
+  std::uint64_t propagateNanoseconds; // Time spent forcing values.
+  std::uint64_t searchNanoseconds; // Time spent searching, including forcing values.
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Adds the counts of another search, for example one run on another thread.  The times
+  /// are added, so for searches run at the same time they are the total over the threads.
+  /// \param other The statistics of the other search.
+  /// \return This.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  SearchStatistics& operator+=( const SearchStatistics& other )
+  {
+    nodes += other.nodes;
+    guesses += other.guesses;
+    backtracks += other.backtracks;
+    propagations += other.propagations;
+    maxDepth = std::max(maxDepth, other.maxDepth);
+    populateNanoseconds += other.populateNanoseconds;
+    propagateNanoseconds += other.propagateNanoseconds;
+    searchNanoseconds += other.searchNanoseconds;
+    return *this;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief StatisticsTimer adds the time from its construction to its destruction to one of the
+/// times of a SearchStatistics.  If SearchStatistics::enabled is false it does nothing.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class StatisticsTimer
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief StatisticsTimer constructor.
+    /// \param nanoseconds The time to add to.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit StatisticsTimer( std::uint64_t& nanoseconds )
+      : nanoseconds_(nanoseconds), start_()
+    {
+      if ( SearchStatistics::enabled )
+      {
+        start_ = std::chrono::steady_clock::now();
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief StatisticsTimer destructor.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ~StatisticsTimer()
+    {
+      if ( SearchStatistics::enabled )
+      {
+        nanoseconds_ += static_cast<std::uint64_t>(std::chrono::duration_cast<
+          std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+      }
+    }
+
+    StatisticsTimer( const StatisticsTimer& ) = delete;
+    StatisticsTimer& operator=( const StatisticsTimer& ) = delete;
+
+  /// Private variables.
+  private:
+    std::uint64_t& nanoseconds_; // The time to add to.
+    std::chrono::steady_clock::time_point start_; // When the timer was made.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,347 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of SolutionCache.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "SolutionCache.h"
+#include "SudokuBitBoard.h"
+#include "SudokuCanonicalizer.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SolutionCache::SolutionCache( std::size_t maxMemory )
+  : capacity_(maxMemory / getEntryMemory()), mutex_(), entries_(), index_(), fingerprints_(),
+    hits_(0), misses_(0)
+{
+  index_.reserve(capacity_);
+  fingerprints_.reserve(capacity_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SolutionCache::solve( const short (&puzzle)[SudokuTables::numberOfGridPoints],
+  short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( puzzle[i] < 0 || puzzle[i] > SudokuTables::boardSize )
+    {
+      throw std::invalid_argument("Grid point " + std::to_string(i) + " has value " +
+        std::to_string(puzzle[i]));
+    }
+  }
+
+  const Key_ key(pack_(puzzle));
+  const std::uint64_t fingerprint(fingerprint_(puzzle));
+  Entry_ entry;
+  Entry_ similar;
+  bool hasSimilar;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if ( find_(key, entry) )
+    {
+      ++hits_;
+      unpack_(entry.solution, solution);
+      return entry.numberOfSolutions;
+    }
+
+    // Only an entry with the same fingerprint can be a transform of the puzzle.
+    const auto found(fingerprints_.find(fingerprint));
+    hasSimilar = found != fingerprints_.end();
+    if ( hasSimilar )
+    {
+      similar = *found->second;
+    }
+  }
+
+  // Each thread keeps its own canonicalizer and solver, which are too big to make for every call.
+  static thread_local SudokuBitBoard solver;
+  if ( ! hasSimilar )
+  {
+    const unsigned long numberOfSolutions(solver.countSolutions(puzzle, 2, solution));
+    if ( numberOfSolutions == 0 )
+    {
+      std::fill(solution, solution + SudokuTables::numberOfGridPoints, 0);
+    }
+    entry = { key, pack_(solution), fingerprint, static_cast<unsigned char>(numberOfSolutions),
+      false };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++misses_;
+    insert_(entry);
+    return numberOfSolutions;
+  }
+
+  static thread_local SudokuCanonicalizer canonicalizer;
+  short canonical[SudokuTables::numberOfGridPoints];
+  const SudokuTransform transform(canonicalizer.canonicalize(puzzle, canonical));
+  const Key_ canonicalKey(pack_(canonical));
+
+  bool found;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    found = find_(canonicalKey, entry);
+  }
+
+  // An entry solved as it was is canonicalized now, its canonical form may be the puzzle's.
+  const bool canonicalizeSimilar(! found && ! similar.canonical);
+  Entry_ similarCanonical;
+  if ( canonicalizeSimilar )
+  {
+    short values[SudokuTables::numberOfGridPoints];
+    short similarPuzzle[SudokuTables::numberOfGridPoints];
+    short similarSolution[SudokuTables::numberOfGridPoints];
+    unpack_(similar.puzzle, values);
+    const SudokuTransform similarTransform(canonicalizer.canonicalize(values, similarPuzzle));
+    unpack_(similar.solution, values);
+    similarTransform.apply(values, similarSolution);
+    similarCanonical = { pack_(similarPuzzle), pack_(similarSolution), fingerprint,
+      similar.numberOfSolutions, true };
+
+    found = similarCanonical.puzzle == canonicalKey;
+    if ( found )
+    {
+      entry = similarCanonical;
+    }
+  }
+
+  short canonicalSolution[SudokuTables::numberOfGridPoints];
+  if ( found )
+  {
+    unpack_(entry.solution, canonicalSolution);
+  }
+  else
+  {
+    const unsigned long numberOfSolutions(solver.countSolutions(canonical, 2, canonicalSolution));
+    if ( numberOfSolutions == 0 )
+    {
+      std::fill(canonicalSolution, canonicalSolution + SudokuTables::numberOfGridPoints, 0);
+    }
+    entry = { canonicalKey, pack_(canonicalSolution), fingerprint,
+      static_cast<unsigned char>(numberOfSolutions), true };
+  }
+
+  transform.inverse().apply(canonicalSolution, solution);
+  const Entry_ puzzleEntry = { key, pack_(solution), fingerprint, entry.numberOfSolutions,
+    false };
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if ( canonicalizeSimilar )
+  {
+    insert_(similarCanonical);
+  }
+  if ( found )
+  {
+    ++hits_;
+  }
+  else
+  {
+    ++misses_;
+    insert_(entry);
+  }
+  if ( ! ( key == canonicalKey ) )
+  {
+    insert_(puzzleEntry);
+  }
+  return entry.numberOfSolutions;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SolutionCache::solve( const SudokuBoard& board,
+  short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  short values[SudokuTables::numberOfGridPoints];
+  board.getValues(values);
+  return solve(values, solution);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SolutionCache::getHits() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SolutionCache::getMisses() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t SolutionCache::getSize() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.clear();
+  index_.clear();
+  fingerprints_.clear();
+  hits_ = 0;
+  misses_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t SolutionCache::getEntryMemory()
+{
+  // A list node holds the entry and two links, a hash table node the key, the iterator, a link and
+  // the hash, and the table has a bucket for each entry.  The table of fingerprints has at most a
+  // node for each entry too.
+  return sizeof(Entry_) + 2 * sizeof(void*) +
+    sizeof(std::pair<const Key_, Entries_::iterator>) + 2 * sizeof(void*) + sizeof(void*) +
+    sizeof(std::pair<const std::uint64_t, Entries_::iterator>) + 2 * sizeof(void*) +
+    sizeof(void*);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SolutionCache::Key_::operator==( const Key_& other ) const
+{
+  return std::equal(words, words + 6, other.words);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t SolutionCache::KeyHash_::operator()( const Key_& key ) const
+{
+  std::uint64_t hash(0);
+  for ( auto word : key.words )
+  {
+    hash = ( hash ^ word ) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 29;
+  }
+  return static_cast<std::size_t>(hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SolutionCache::Key_ SolutionCache::pack_( const short (&board)[SudokuTables::numberOfGridPoints] )
+{
+  Key_ key = { { 0 } };
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    key.words[i / 16] |= static_cast<std::uint64_t>(board[i]) << ( 4 * ( i % 16 ) );
+  }
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCache::unpack_( const Key_& key, short (&board)[SudokuTables::numberOfGridPoints] )
+{
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    board[i] = static_cast<short>(( key.words[i / 16] >> ( 4 * ( i % 16 ) ) ) & 0xF);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::uint64_t SolutionCache::fingerprint_(
+  const short (&board)[SudokuTables::numberOfGridPoints] )
+{
+  const short boardSize(SudokuTables::boardSize);
+  short rows[boardSize] = { 0 };
+  short columns[boardSize] = { 0 };
+  short values[boardSize + 1] = { 0 };
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( board[i] != 0 )
+    {
+      ++rows[i / boardSize];
+      ++columns[i % boardSize];
+      ++values[board[i]];
+    }
+  }
+
+  // The counts of each band sorted, then the bands sorted, 4 bits to a count.
+  const auto packBands([]( short (&counts)[boardSize] )
+  {
+    std::uint64_t bands[3];
+    for ( short band(0); band < 3; ++band )
+    {
+      std::sort(counts + band * 3, counts + band * 3 + 3);
+      bands[band] = static_cast<std::uint64_t>(
+        counts[band * 3] << 8 | counts[band * 3 + 1] << 4 | counts[band * 3 + 2]);
+    }
+    std::sort(bands, bands + 3);
+    return bands[0] << 24 | bands[1] << 12 | bands[2];
+  });
+
+  // The rows and columns are swapped by a transform, so their order is not kept.
+  const std::uint64_t rowBands(packBands(rows));
+  const std::uint64_t columnBands(packBands(columns));
+  std::sort(values + 1, values + boardSize + 1);
+  std::uint64_t valueCounts(0);
+  for ( short value(1); value <= boardSize; ++value )
+  {
+    valueCounts = valueCounts << 4 | static_cast<std::uint64_t>(values[value]);
+  }
+
+  std::uint64_t hash(0);
+  for ( auto word : { std::min(rowBands, columnBands), std::max(rowBands, columnBands),
+                      valueCounts } )
+  {
+    hash = ( hash ^ word ) * 0x9E3779B97F4A7C15ull;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SolutionCache::find_( const Key_& puzzle, Entry_& entry )
+{
+  const auto found(index_.find(puzzle));
+  if ( found == index_.end() )
+  {
+    return false;
+  }
+
+  entries_.splice(entries_.begin(), entries_, found->second);
+  entry = *found->second;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCache::insert_( const Entry_& entry )
+{
+  if ( capacity_ == 0 )
+  {
+    return;
+  }
+
+  const auto found(index_.find(entry.puzzle));
+  if ( found != index_.end() )
+  {
+    *found->second = entry;
+    entries_.splice(entries_.begin(), entries_, found->second);
+    return;
+  }
+
+  if ( entries_.size() == capacity_ )
+  {
+    // The fingerprint is dropped too if this was the entry added last with it.
+    const auto last(std::prev(entries_.end()));
+    const auto fingerprint(fingerprints_.find(last->fingerprint));
+    if ( fingerprint != fingerprints_.end() && fingerprint->second == last )
+    {
+      fingerprints_.erase(fingerprint);
+    }
+    index_.erase(last->puzzle);
+    entries_.pop_back();
+  }
+  entries_.push_front(entry);
+  index_.emplace(entry.puzzle, entries_.begin());
+  fingerprints_[entry.fingerprint] = entries_.begin();
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,181 @@
+#ifndef __sudoku_solutioncache_h__
+#define __sudoku_solutioncache_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SolutionCache.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+#include "SudokuBoard.h"
+#include "SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SolutionCache solves 9x9 puzzles, keeping the results of the puzzles seen most recently.
+/// A puzzle seen again exactly is answered from its entry.  Canonicalizing takes longer than
+/// solving most puzzles, so a puzzle not seen before is only canonicalized if an entry has the
+/// same fingerprint, which no transform changes: the numbers of values in the rows of each band,
+/// the columns of each stack, and of each value.  Otherwise it is solved as it is.  When it is
+/// canonicalized, a puzzle that is a transform of one already solved is answered by taking the
+/// solution of the canonical form back through the inverse transform, and the canonical form is
+/// kept as well as the puzzle.  An entry solved as it was is canonicalized the first time a
+/// puzzle with its fingerprint is.  When the cache is full the entry used least recently is
+/// dropped.  The cache can be shared between threads, the solving and canonicalizing is done
+/// outside its lock.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SolutionCache
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief SolutionCache constructor.
+    /// \param maxMemory The most memory, in bytes, to use for entries, each takes getEntryMemory.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit SolutionCache( std::size_t maxMemory );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves a puzzle, using the cache if it or a transform of it has been solved.
+    /// \param puzzle The values row by row, 0 if the grid point has no value.
+    /// \param solution Filled with a solution row by row, if there is one.
+    /// \return The number of solutions, 0, 1, or 2 for more than one.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long solve( const short (&puzzle)[SudokuTables::numberOfGridPoints],
+      short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the current values of a board, using the cache.
+    /// \param board The board.
+    /// \param solution Filled with a solution row by row, if there is one.
+    /// \return The number of solutions, 0, 1, or 2 for more than one.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long solve( const SudokuBoard& board,
+      short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of calls to solve answered from the cache.
+    /// \return The number of hits.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getHits() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of calls to solve that had to solve the puzzle.
+    /// \return The number of misses.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getMisses() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of entries in the cache.
+    /// \return The number of entries.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the most entries the cache holds.
+    /// \return The capacity.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t getCapacity() const
+    {
+      return capacity_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Drops every entry, and sets the hits and misses to 0.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the memory used by an entry, including that used by the list and hash table.
+    /// \return The number of bytes.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::size_t getEntryMemory();
+
+  /// Private types.
+  private:
+    // A board packed with 4 bits for each value.
+    struct Key_
+    {
+      std::uint64_t words[6]; // The values, 16 to a word.
+
+      bool operator==( const Key_& other ) const;
+    };
+
+    // Hash of a Key_.
+    struct KeyHash_
+    {
+      std::size_t operator()( const Key_& key ) const;
+    };
+
+    // An entry in the cache.
+    struct Entry_
+    {
+      Key_ puzzle; // The puzzle.
+      Key_ solution; // Its solution, all 0 if it has none.
+      std::uint64_t fingerprint; // The fingerprint of the puzzle.
+      unsigned char numberOfSolutions; // 0, 1, or 2 for more than one.
+      bool canonical; // Whether the puzzle is a canonical form.
+    };
+
+    typedef std::list<Entry_> Entries_; // The entries, most recently used first.
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Packs a board into a key.
+    /// \param board The values row by row.
+    /// \return The key.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static Key_ pack_( const short (&board)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Unpacks a key into a board.
+    /// \param key The key.
+    /// \param board Filled with the values row by row.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void unpack_( const Key_& key, short (&board)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the fingerprint of a board, which is the same for every transform of it.
+    /// \param board The values row by row.
+    /// \return The fingerprint.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static std::uint64_t fingerprint_( const short (&board)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds an entry, making it the most recently used.  Must be called with mutex_ locked.
+    /// \param puzzle The puzzle.
+    /// \param entry Set to the entry if it is found.
+    /// \return true if the entry is found, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool find_( const Key_& puzzle, Entry_& entry );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Adds an entry, or replaces it if it is there, dropping the least recently used entry
+    /// if the cache is full.  Must be called with mutex_ locked.
+    /// \param entry The entry.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void insert_( const Entry_& entry );
+
+  /// Private variables.
+  private:
+    const std::size_t capacity_; // The most entries held.
+    mutable std::mutex mutex_; // Locked while the entries or counts are used.
+    Entries_ entries_; // The entries, most recently used first.
+    std::unordered_map<Key_, Entries_::iterator, KeyHash_> index_; // The entry of each puzzle.
+
+    // The entry added last with each fingerprint.
+    std::unordered_map<std::uint64_t, Entries_::iterator> fingerprints_;
+    unsigned long hits_; // The number of calls answered from the cache.
+    unsigned long misses_; // The number of calls that had to solve.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef __sudoku_solvelimits_h__
+#define __sudoku_solvelimits_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SolveLimits.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SolveLimits bounds the work of a search: a time it must stop by, a most number of
+/// guesses, and a flag another thread can set to cancel it.  The search checks them every few
+/// hundred guesses, so it can run a little past the deadline, but never past the guesses.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SolveLimits
+{
+  typedef std::chrono::steady_clock Clock; // The clock the deadline is on.
+
+  Clock::time_point deadline; // The search stops once this time has passed.
+  unsigned long maxGuesses; // The search stops once it has made this many guesses.
+  const std::atomic<bool>* cancelled; // If not null, the search stops soon after this is set.
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Makes the limits that never stop a search.
+  /// \return The limits.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  static SolveLimits none()
+  {
+    const SolveLimits limits = { Clock::time_point::max(),
+      std::numeric_limits<unsigned long>::max(), nullptr };
+    return limits;
+  }
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Makes the limits that stop a search after some time from now.
+  /// \param timeout The time the search may take.
+  /// \return The limits.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  static SolveLimits within( Clock::duration timeout )
+  {
+    SolveLimits limits(none());
+    limits.deadline = Clock::now() + timeout;
+    return limits;
+  }
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -3,14 +3,1133 @@
 /// \author anon.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
 #include "SudokuAssist.h"
 
 namespace sudoku
 {
 
+namespace
+{
+
+typedef SudokuTables Tables;
+
+const ValueMask allValues(allValuesMask(Tables::boardSize)); // Every value, also every position.
+const unsigned int boxColumn(0x49); // The positions in a box of its first column.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Makes the GridBits with just the bit for a grid point set.
+/// \param gridPoint The grid point.
+/// \return The GridBits.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+GridBits gridPointBits( short gridPoint )
+{
+  return gridPoint < 64 ? makeGridBits(static_cast<std::uint64_t>(1) << gridPoint, 0) :
+    makeGridBits(0, static_cast<std::uint64_t>(1) << ( gridPoint - 64 ));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Makes the GridBits of some positions in a unit.
+/// \param unit The unit.
+/// \param positions The positions, bit i for the grid point Tables::getUnit(unit)[i].
+/// \return The GridBits.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+GridBits unitBits( short unit, unsigned int positions )
+{
+  GridBits bits(makeGridBits(0, 0));
+  for ( ; positions != 0; positions &= positions - 1 )
+  {
+    bits = bits | gridPointBits(Tables::getUnit(unit)[__builtin_ctz(positions)]);
+  }
+  return bits;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the position of a grid point in one of its units.
+/// \param gridPoint The grid point.
+/// \param which 0 for its row, 1 for its column, 2 for its box, as Tables::getUnitsOf.
+/// \return The position, the index of the grid point in Tables::getUnit.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short getPosition( short gridPoint, short which )
+{
+  const short x(gridPoint / Tables::boardSize);
+  const short y(gridPoint % Tables::boardSize);
+  return which == 0 ? y : which == 1 ? x :
+    ( x % Tables::boxSize ) * Tables::boxSize + y % Tables::boxSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the next mask with size bits set taken from a mask, in increasing order.  To go
+/// through every such mask use:
+///   for ( unsigned int s(nextSubset(mask, size, 0)); s != 0; s = nextSubset(mask, size, s) )
+/// \param mask The mask.
+/// \param size The number of bits.
+/// \param subset The last mask, 0 for the first.
+/// \return The next mask, 0 if there are no more.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int nextSubset( unsigned int mask, short size, unsigned int subset )
+{
+  // Go through the submasks of mask in increasing order, skipping those of the wrong size.
+  do
+  {
+    subset = ( subset - mask ) & mask;
+  }
+  while ( subset != 0 && countValues(subset) != size );
+  return subset;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Adds the name of a grid point, r<row>c<column> counting from 1.
+/// \param gridPoint The grid point.
+/// \param text Has the name added.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void appendGridPoint( short gridPoint, std::string& text )
+{
+  text += 'r';
+  text += static_cast<char>('1' + gridPoint / Tables::boardSize);
+  text += 'c';
+  text += static_cast<char>('1' + gridPoint % Tables::boardSize);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Adds the names of some grid points, separated by commas.
+/// \param gridPoints The grid points.
+/// \param text Has the names added.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void appendGridPoints( GridBits gridPoints, std::string& text )
+{
+  for ( bool first(true); ! isEmpty(gridPoints); first = false )
+  {
+    const short gridPoint(lowestGridPoint(gridPoints));
+    gridPoints = andNot(gridPoints, gridPointBits(gridPoint));
+    text += first ? "" : ", ";
+    appendGridPoint(gridPoint, text);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Adds some values.
+/// \param values The values.
+/// \param separator Put between the values.
+/// \param text Has the values added.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void appendValues( ValueMask values, const char* separator, std::string& text )
+{
+  for ( bool first(true); values != 0; values &= values - 1, first = false )
+  {
+    text += first ? "" : separator;
+    text += static_cast<char>('0' + lowestValue(values));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Adds the name of a unit, such as "row 3".
+/// \param unit The unit.
+/// \param text Has the name added.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void appendUnit( short unit, std::string& text )
+{
+  static const char* const kinds[] = { "row ", "column ", "box " };
+  text += kinds[unit / Tables::boardSize];
+  text += static_cast<char>('1' + unit % Tables::boardSize);
+}
+
+} // End of anonymous namespace.
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 SudokuAssist::SudokuAssist()
+  : state_(), fixed_(makeGridBits(0, 0)), solved_(false)
+{
+  std::fill(uses_, uses_ + numberOfTechniques, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::solve( const short (&values)[Tables::numberOfGridPoints],
+  short (&result)[Tables::numberOfGridPoints] )
+{
+  solved_ = start_(values) && run_();
+  std::copy(state_.values, state_.values + Tables::numberOfGridPoints, result);
+  return solved_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Technique SudokuAssist::rate( const short (&values)[Tables::numberOfGridPoints] )
+{
+  solved_ = start_(values) && run_();
+  return getHardestTechnique();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+Technique SudokuAssist::getHardestTechnique() const
+{
+  if ( ! solved_ )
+  {
+    return Technique::Guessing;
+  }
+
+  short hardest(numberOfTechniques - 1);
+  while ( hardest > 0 && uses_[hardest] == 0 )
+  {
+    --hardest;
+  }
+  return static_cast<Technique>(hardest);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+const char* SudokuAssist::getTechniqueName( Technique technique )
+{
+  static const char* const names[numberOfTechniques] = { "None", "Hidden single", "Naked single",
+    "Locked candidates", "Naked subset", "Hidden subset", "X-Wing", "Swordfish", "XY-Wing",
+    "Simple chain", "Guessing" };
+  return names[static_cast<short>(technique)];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::start( const short (&values)[Tables::numberOfGridPoints] )
+{
+  solved_ = false;
+  if ( start_(values) )
+  {
+    return true;
+  }
+
+  // Start on an empty board rather than keep the values before the one given twice.
+  const short empty[Tables::numberOfGridPoints] = {};
+  start_(empty);
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::place( short x, short y, short value )
+{
+  const short gridPoint(getGridPoint_(x, y));
+  if ( value < 1 || value > Tables::boardSize )
+  {
+    throw std::invalid_argument("Value " + std::to_string(value) + " is out of range");
+  }
+
+  if ( state_.values[gridPoint] != 0 || ( state_.possible[gridPoint] & valueToMask(value) ) == 0 )
+  {
+    return false;
+  }
+  place_(gridPoint, value);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::erase( short x, short y )
+{
+  const short gridPoint(getGridPoint_(x, y));
+  if ( state_.values[gridPoint] == 0 || hasGridPoint(fixed_, gridPoint) )
+  {
+    return false;
+  }
+  erase_(gridPoint);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::getValues( short (&values)[Tables::numberOfGridPoints] ) const
+{
+  std::copy(state_.values, state_.values + Tables::numberOfGridPoints, values);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::nextHint( SudokuHint& hint )
+{
+  if ( state_.unsolved == 0 || state_.contradictions > 0 )
+  {
+    return false;
+  }
+
+  // Make deductions until one gives a value, then put the session back.
+  const State_ session(state_);
+  Technique hardest(Technique::None);
+  std::string explanation;
+  Deduction_ deduction;
+  bool found(false);
+
+  while ( ! found && state_.contradictions == 0 && findDeduction_(deduction) )
+  {
+    hardest = std::max(hardest, deduction.technique);
+    explanation += explanation.empty() ? "" : " ";
+    describe_(deduction, explanation);
+    found = deduction.gridPoint >= 0;
+    if ( ! found )
+    {
+      apply_(deduction);
+    }
+  }
+  state_ = session;
+
+  if ( found )
+  {
+    hint.x = deduction.gridPoint / Tables::boardSize;
+    hint.y = deduction.gridPoint % Tables::boardSize;
+    hint.value = deduction.value;
+    hint.technique = hardest;
+    hint.explanation.swap(explanation);
+  }
+  return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuAssist::Deduction_ SudokuAssist::makeRemoval_( Technique technique, ValueMask values )
+{
+  const Deduction_ deduction = { technique, -1, 0, values, makeGridBits(0, 0), -1,
+    makeGridBits(0, 0) };
+  return deduction;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuAssist::getGridPoint_( short x, short y )
+{
+  if ( x < 0 || x >= Tables::boardSize || y < 0 || y >= Tables::boardSize )
+  {
+    throw std::invalid_argument("Grid point " + std::to_string(x) + ", " + std::to_string(y) +
+      " is out of range");
+  }
+  return x * Tables::boardSize + y;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::start_( const short (&values)[Tables::numberOfGridPoints] )
+{
+  for ( short i(0); i < Tables::numberOfGridPoints; ++i )
+  {
+    if ( values[i] < 0 || values[i] > Tables::boardSize )
+    {
+      throw std::invalid_argument("Grid point " + std::to_string(i) + " has value " +
+        std::to_string(values[i]));
+    }
+  }
+
+  std::fill(state_.values, state_.values + Tables::numberOfGridPoints, 0);
+  std::fill(state_.possible, state_.possible + Tables::numberOfGridPoints, allValues);
+  std::fill(&state_.places[0][0],
+    &state_.places[0][0] + Tables::numberOfUnits * Tables::boardSize, allValues);
+  std::fill(state_.given, state_.given + Tables::numberOfUnits, 0);
+  std::fill(state_.hiddenSingles, state_.hiddenSingles + Tables::numberOfUnits, 0);
+  std::fill(uses_, uses_ + numberOfTechniques, 0);
+  state_.nakedSingles = makeGridBits(0, 0);
+  state_.contradictions = 0;
+  state_.unsolved = Tables::numberOfGridPoints;
+  fixed_ = makeGridBits(0, 0);
+
+  bool valid(true);
+  for ( short i(0); i < Tables::numberOfGridPoints; ++i )
+  {
+    if ( values[i] != 0 )
+    {
+      // A value already removed by a peer is given twice in a unit.
+      valid = valid && ( state_.possible[i] & valueToMask(values[i]) ) != 0;
+      if ( valid )
+      {
+        place_(i, values[i]);
+        fixed_ = fixed_ | gridPointBits(i);
+      }
+    }
+  }
+
+  return valid;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::run_()
+{
+  Deduction_ deduction;
+
+  while ( state_.unsolved > 0 )
+  {
+    if ( state_.contradictions > 0 || ! findDeduction_(deduction) )
+    {
+      return false;
+    }
+    apply_(deduction);
+    ++uses_[static_cast<short>(deduction.technique)];
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findDeduction_( Deduction_& deduction ) const
+{
+  if ( findHiddenSingle_(deduction) || findNakedSingle_(deduction) ||
+       findLockedCandidates_(deduction) )
+  {
+    return true;
+  }
+
+  for ( short size(2); size <= 4; ++size )
+  {
+    if ( findNakedSubset_(size, deduction) || findHiddenSubset_(size, deduction) )
+    {
+      return true;
+    }
+  }
+
+  return findFish_(2, deduction) || findFish_(3, deduction) || findXYWing_(deduction) ||
+    findSimpleChain_(deduction);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::apply_( const Deduction_& deduction )
+{
+  if ( deduction.gridPoint >= 0 )
+  {
+    place_(deduction.gridPoint, deduction.value);
+    return;
+  }
+
+  for ( GridBits gridPoints(deduction.gridPoints); ! isEmpty(gridPoints); )
+  {
+    const short gridPoint(lowestGridPoint(gridPoints));
+    gridPoints = andNot(gridPoints, gridPointBits(gridPoint));
+    for ( ValueMask valueIter(state_.possible[gridPoint] & deduction.values); valueIter != 0;
+          valueIter &= valueIter - 1 )
+    {
+      removeValue_(gridPoint, lowestValue(valueIter));
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::place_( short gridPoint, short value )
+{
+  state_.values[gridPoint] = value;
+  --state_.unsolved;
+
+  const short* units(Tables::getUnitsOf(gridPoint));
+  for ( short which(0); which < 3; ++which )
+  {
+    state_.given[units[which]] |= valueToMask(value);
+    state_.hiddenSingles[units[which]] &= ~valueToMask(value);
+  }
+
+  for ( ValueMask valueIter(state_.possible[gridPoint]); valueIter != 0;
+        valueIter &= valueIter - 1 )
+  {
+    removeValue_(gridPoint, lowestValue(valueIter));
+  }
+  state_.nakedSingles = andNot(state_.nakedSingles, gridPointBits(gridPoint));
+
+  const Tables::Index* peers(Tables::getPeers(gridPoint));
+  for ( short i(0); i < Tables::numberOfPeers; ++i )
+  {
+    removeValue_(peers[i], value);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::removeValue_( short gridPoint, short value )
+{
+  if ( ( state_.possible[gridPoint] & valueToMask(value) ) == 0 )
+  {
+    return;
+  }
+
+  state_.possible[gridPoint] &= ~valueToMask(value);
+  if ( state_.values[gridPoint] == 0 )
+  {
+    const ValueMask possible(state_.possible[gridPoint]);
+    if ( possible != 0 && ( possible & ( possible - 1 ) ) == 0 )
+    {
+      state_.nakedSingles = state_.nakedSingles | gridPointBits(gridPoint);
+    }
+    else if ( possible == 0 )
+    {
+      state_.nakedSingles = andNot(state_.nakedSingles, gridPointBits(gridPoint));
+      ++state_.contradictions;
+    }
+  }
+
+  const short* units(Tables::getUnitsOf(gridPoint));
+  for ( short which(0); which < 3; ++which )
+  {
+    const short unit(units[which]);
+    if ( ( state_.given[unit] & valueToMask(value) ) == 0 )
+    {
+      const unsigned int positions(state_.places[unit][value - 1] &
+        ~( 1u << getPosition(gridPoint, which) ));
+      state_.places[unit][value - 1] = static_cast<unsigned short>(positions);
+      if ( positions != 0 && ( positions & ( positions - 1 ) ) == 0 )
+      {
+        state_.hiddenSingles[unit] |= valueToMask(value);
+      }
+      else if ( positions == 0 )
+      {
+        state_.hiddenSingles[unit] &= ~valueToMask(value);
+        ++state_.contradictions;
+      }
+    }
+    else
+    {
+      state_.places[unit][value - 1] = 0;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::erase_( short gridPoint )
+{
+  const short value(state_.values[gridPoint]);
+  state_.values[gridPoint] = 0;
+  ++state_.unsolved;
+
+  // Until they are restored the grid point has nothing possible and the value has no place in
+  // its units.
+  const short* units(Tables::getUnitsOf(gridPoint));
+  ValueMask given(0);
+  for ( short which(0); which < 3; ++which )
+  {
+    state_.given[units[which]] &= ~valueToMask(value);
+    given |= state_.given[units[which]];
+  }
+  state_.contradictions += 4;
+
+  for ( ValueMask valueIter(allValues & ~given); valueIter != 0; valueIter &= valueIter - 1 )
+  {
+    restoreValue_(gridPoint, lowestValue(valueIter));
+  }
+
+  const Tables::Index* peers(Tables::getPeers(gridPoint));
+  for ( short i(0); i < Tables::numberOfPeers; ++i )
+  {
+    const short peer(peers[i]);
+    const short* peerUnits(Tables::getUnitsOf(peer));
+    if ( state_.values[peer] == 0 && ( ( state_.given[peerUnits[0]] |
+         state_.given[peerUnits[1]] | state_.given[peerUnits[2]] ) & valueToMask(value) ) == 0 )
+    {
+      restoreValue_(peer, value);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::restoreValue_( short gridPoint, short value )
+{
+  if ( ( state_.possible[gridPoint] & valueToMask(value) ) != 0 )
+  {
+    return;
+  }
+
+  const ValueMask possible(state_.possible[gridPoint]);
+  state_.possible[gridPoint] |= valueToMask(value);
+  if ( possible == 0 )
+  {
+    state_.nakedSingles = state_.nakedSingles | gridPointBits(gridPoint);
+    --state_.contradictions;
+  }
+  else if ( ( possible & ( possible - 1 ) ) == 0 )
+  {
+    state_.nakedSingles = andNot(state_.nakedSingles, gridPointBits(gridPoint));
+  }
+
+  const short* units(Tables::getUnitsOf(gridPoint));
+  for ( short which(0); which < 3; ++which )
+  {
+    const short unit(units[which]);
+    const unsigned int positions(state_.places[unit][value - 1]);
+    state_.places[unit][value - 1] =
+      static_cast<unsigned short>(positions | ( 1u << getPosition(gridPoint, which) ));
+    if ( positions == 0 )
+    {
+      state_.hiddenSingles[unit] |= valueToMask(value);
+      --state_.contradictions;
+    }
+    else if ( ( positions & ( positions - 1 ) ) == 0 )
+    {
+      state_.hiddenSingles[unit] &= ~valueToMask(value);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::addRemovals_( short unit, unsigned int positions, Deduction_& deduction ) const
+{
+  const Tables::Index* gridPoints(Tables::getUnit(unit));
+  for ( unsigned int positionIter(positions); positionIter != 0;
+        positionIter &= positionIter - 1 )
+  {
+    const short gridPoint(gridPoints[__builtin_ctz(positionIter)]);
+    if ( ( state_.possible[gridPoint] & deduction.values ) != 0 )
+    {
+      deduction.gridPoints = deduction.gridPoints | gridPointBits(gridPoint);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned int SudokuAssist::getUnsolvedPositions_( short unit ) const
+{
+  const Tables::Index* gridPoints(Tables::getUnit(unit));
+  unsigned int positions(0);
+  for ( short i(0); i < Tables::boardSize; ++i )
+  {
+    if ( state_.values[gridPoints[i]] == 0 )
+    {
+      positions |= 1u << i;
+    }
+  }
+  return positions;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssist::describe_( const Deduction_& deduction, std::string& description ) const
+{
+  const short value(deduction.gridPoint >= 0 ? deduction.value : lowestValue(deduction.values));
+  const char digit(static_cast<char>('0' + value));
+
+  switch ( deduction.technique )
+  {
+    case Technique::HiddenSingle:
+      description += "In ";
+      appendUnit(deduction.unit, description);
+      description += std::string(", ") + digit + " can only go at ";
+      appendGridPoint(deduction.gridPoint, description);
+      description += '.';
+      return;
+
+    case Technique::NakedSingle:
+      appendGridPoint(deduction.gridPoint, description);
+      description += std::string(" can only be ") + digit + '.';
+      return;
+
+    case Technique::LockedCandidates:
+    {
+      // The value is locked in the intersection of the unit and a row, column or box.
+      const short gridPoint(lowestGridPoint(deduction.pattern));
+      const short x(gridPoint / Tables::boardSize);
+      const short y(gridPoint % Tables::boardSize);
+      short other(Tables::getUnitsOf(gridPoint)[2]);
+      if ( deduction.unit >= 2 * Tables::boardSize )
+      {
+        other = isEmpty(andNot(deduction.pattern, unitBits(x, allValues))) ? x :
+          static_cast<short>(Tables::boardSize + y);
+      }
+      description += "In ";
+      appendUnit(deduction.unit, description);
+      description += std::string(", ") + digit + " can only go in ";
+      appendUnit(other, description);
+      description += ", so it cannot go at ";
+      break;
+    }
+
+    case Technique::NakedSubset:
+      description += "In ";
+      appendUnit(deduction.unit, description);
+      description += ", ";
+      appendGridPoints(deduction.pattern, description);
+      description += " can only be ";
+      appendValues(deduction.values, ", ", description);
+      description += ", so they cannot go at ";
+      break;
+
+    case Technique::HiddenSubset:
+      description += "In ";
+      appendUnit(deduction.unit, description);
+      description += ", ";
+      appendValues(allValues & ~deduction.values, ", ", description);
+      description += " can only go at ";
+      appendGridPoints(deduction.pattern, description);
+      description += ", so no other value can go at ";
+      break;
+
+    case Technique::XWing:
+    case Technique::Swordfish:
+    {
+      // The lines are the rows or columns of the pattern, whichever the fish is based on.
+      const bool rows(deduction.unit < Tables::boardSize);
+      ValueMask base(0);
+      ValueMask cover(0);
+      for ( GridBits gridPoints(deduction.pattern); ! isEmpty(gridPoints); )
+      {
+        const short gridPoint(lowestGridPoint(gridPoints));
+        gridPoints = andNot(gridPoints, gridPointBits(gridPoint));
+        base |= valueToMask(( rows ? gridPoint / Tables::boardSize :
+          gridPoint % Tables::boardSize ) + 1);
+        cover |= valueToMask(( rows ? gridPoint % Tables::boardSize :
+          gridPoint / Tables::boardSize ) + 1);
+      }
+      description += rows ? "In rows " : "In columns ";
+      appendValues(base, ", ", description);
+      description += std::string(", ") + digit + " can only go in " +
+        ( rows ? "columns " : "rows " );
+      appendValues(cover, ", ", description);
+      description += ", so it cannot go at ";
+      break;
+    }
+
+    case Technique::XYWing:
+    {
+      // The pivot is the grid point of the pattern that cannot be the value.
+      short pivot(-1);
+      GridBits pincers(deduction.pattern);
+      for ( GridBits gridPoints(deduction.pattern); pivot < 0; )
+      {
+        const short gridPoint(lowestGridPoint(gridPoints));
+        gridPoints = andNot(gridPoints, gridPointBits(gridPoint));
+        if ( ( state_.possible[gridPoint] & deduction.values ) == 0 )
+        {
+          pivot = gridPoint;
+          pincers = andNot(pincers, gridPointBits(gridPoint));
+        }
+      }
+      appendGridPoint(pivot, description);
+      description += " is ";
+      appendValues(state_.possible[pivot], " or ", description);
+      description += ", so one of ";
+      appendGridPoints(pincers, description);
+      description += std::string(" is ") + digit + ", and it cannot go at ";
+      break;
+    }
+
+    default:
+      description += std::string("The places of ") + digit + " in ";
+      appendGridPoints(deduction.pattern, description);
+      description += " alternate, so it cannot go at ";
+      break;
+  }
+
+  appendGridPoints(deduction.gridPoints, description);
+  description += '.';
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findHiddenSingle_( Deduction_& deduction ) const
+{
+  for ( short unit(0); unit < Tables::numberOfUnits; ++unit )
+  {
+    if ( state_.hiddenSingles[unit] != 0 )
+    {
+      const short value(lowestValue(state_.hiddenSingles[unit]));
+      deduction.technique = Technique::HiddenSingle;
+      deduction.gridPoint =
+        Tables::getUnit(unit)[__builtin_ctz(state_.places[unit][value - 1])];
+      deduction.value = value;
+      deduction.unit = unit;
+      return true;
+    }
+  }
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findNakedSingle_( Deduction_& deduction ) const
+{
+  if ( isEmpty(state_.nakedSingles) )
+  {
+    return false;
+  }
+
+  deduction.technique = Technique::NakedSingle;
+  deduction.gridPoint = lowestGridPoint(state_.nakedSingles);
+  deduction.value = lowestValue(state_.possible[deduction.gridPoint]);
+  deduction.unit = -1;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findLockedCandidates_( Deduction_& deduction ) const
+{
+  const short boxSize(Tables::boxSize);
+  const unsigned int boxRow(allValuesMask(boxSize)); // The positions in a box of its first row.
+
+  for ( short value(1); value <= Tables::boardSize; ++value )
+  {
+    deduction = makeRemoval_(Technique::LockedCandidates, valueToMask(value));
+
+    for ( short box(0); box < Tables::boardSize; ++box )
+    {
+      const unsigned int positions(state_.places[2 * Tables::boardSize + box][value - 1]);
+      if ( positions == 0 )
+      {
+        continue;
+      }
+
+      // If the value can only go in one row or column of the box it cannot go elsewhere in it.
+      const short firstX(( box / boxSize ) * boxSize);
+      const short firstY(( box % boxSize ) * boxSize);
+      for ( short i(0); i < boxSize; ++i )
+      {
+        if ( ( positions & ~( boxRow << ( boxSize * i ) ) ) == 0 )
+        {
+          addRemovals_(firstX + i, allValues & ~( boxRow << firstY ), deduction);
+        }
+        if ( ( positions & ~( boxColumn << i ) ) == 0 )
+        {
+          addRemovals_(Tables::boardSize + firstY + i, allValues & ~( boxRow << firstX ),
+            deduction);
+        }
+      }
+      if ( ! isEmpty(deduction.gridPoints) )
+      {
+        deduction.unit = 2 * Tables::boardSize + box;
+        deduction.pattern = unitBits(deduction.unit, positions);
+        return true;
+      }
+    }
+
+    for ( short line(0); line < 2 * Tables::boardSize; ++line )
+    {
+      const unsigned int positions(state_.places[line][value - 1]);
+      if ( positions == 0 )
+      {
+        continue;
+      }
+
+      // If the value can only go in one box of a row or column it cannot go elsewhere in the box.
+      const bool row(line < Tables::boardSize);
+      const short index(line % Tables::boardSize);
+      for ( short i(0); i < boxSize; ++i )
+      {
+        if ( ( positions & ~( boxRow << ( boxSize * i ) ) ) == 0 )
+        {
+          const short box(row ? ( index / boxSize ) * boxSize + i : i * boxSize + index / boxSize);
+          const unsigned int inLine(row ? boxRow << ( boxSize * ( index % boxSize ) ) :
+            boxColumn << ( index % boxSize ));
+          addRemovals_(2 * Tables::boardSize + box, allValues & ~inLine, deduction);
+        }
+      }
+      if ( ! isEmpty(deduction.gridPoints) )
+      {
+        deduction.unit = line;
+        deduction.pattern = unitBits(line, positions);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findNakedSubset_( short size, Deduction_& deduction ) const
+{
+  for ( short unit(0); unit < Tables::numberOfUnits; ++unit )
+  {
+    const Tables::Index* gridPoints(Tables::getUnit(unit));
+    const unsigned int unsolved(getUnsolvedPositions_(unit));
+    if ( countValues(unsolved) <= size )
+    {
+      continue;
+    }
+
+    // Only the grid points with at most size values can be in the subset.
+    unsigned int candidates(0);
+    for ( unsigned int positionIter(unsolved); positionIter != 0;
+          positionIter &= positionIter - 1 )
+    {
+      const short position(static_cast<short>(__builtin_ctz(positionIter)));
+      if ( countValues(state_.possible[gridPoints[position]]) <= size )
+      {
+        candidates |= 1u << position;
+      }
+    }
+
+    for ( unsigned int subset(nextSubset(candidates, size, 0)); subset != 0;
+          subset = nextSubset(candidates, size, subset) )
+    {
+      ValueMask values(0);
+      for ( unsigned int positionIter(subset); positionIter != 0;
+            positionIter &= positionIter - 1 )
+      {
+        values |= state_.possible[gridPoints[__builtin_ctz(positionIter)]];
+      }
+
+      if ( countValues(values) == size )
+      {
+        // The values must go in the subset, so cannot go at the other grid points of the unit.
+        deduction = makeRemoval_(Technique::NakedSubset, values);
+        addRemovals_(unit, unsolved & ~subset, deduction);
+        if ( ! isEmpty(deduction.gridPoints) )
+        {
+          deduction.unit = unit;
+          deduction.pattern = unitBits(unit, subset);
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findHiddenSubset_( short size, Deduction_& deduction ) const
+{
+  for ( short unit(0); unit < Tables::numberOfUnits; ++unit )
+  {
+    const ValueMask missing(allValues & ~state_.given[unit]);
+    if ( countValues(missing) <= size )
+    {
+      continue;
+    }
+
+    // Only the values with at most size positions can be in the subset.
+    ValueMask candidates(0);
+    for ( ValueMask valueIter(missing); valueIter != 0; valueIter &= valueIter - 1 )
+    {
+      const short value(lowestValue(valueIter));
+      if ( countValues(state_.places[unit][value - 1]) <= size )
+      {
+        candidates |= valueToMask(value);
+      }
+    }
+
+    for ( ValueMask subset(nextSubset(candidates, size, 0)); subset != 0;
+          subset = nextSubset(candidates, size, subset) )
+    {
+      unsigned int positions(0);
+      for ( ValueMask valueIter(subset); valueIter != 0; valueIter &= valueIter - 1 )
+      {
+        positions |= state_.places[unit][lowestValue(valueIter) - 1];
+      }
+
+      if ( countValues(positions) == size )
+      {
+        // The subset must go at the positions, so no other value can go there.
+        deduction = makeRemoval_(Technique::HiddenSubset, allValues & ~subset);
+        addRemovals_(unit, positions, deduction);
+        if ( ! isEmpty(deduction.gridPoints) )
+        {
+          deduction.unit = unit;
+          deduction.pattern = unitBits(unit, positions);
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findFish_( short size, Deduction_& deduction ) const
 {
+  const Technique technique(size == 2 ? Technique::XWing : Technique::Swordfish);
+
+  for ( short value(1); value <= Tables::boardSize; ++value )
+  {
+    // The base lines are rows and the cover lines columns, then the other way round.  The
+    // positions in a row are columns and the positions in a column are rows.
+    for ( short base(0); base <= Tables::boardSize; base += Tables::boardSize )
+    {
+      const short cover(Tables::boardSize - base);
+
+      unsigned int lines(0);
+      for ( short line(0); line < Tables::boardSize; ++line )
+      {
+        const short number(countValues(state_.places[base + line][value - 1]));
+        if ( number >= 2 && number <= size )
+        {
+          lines |= 1u << line;
+        }
+      }
+
+      for ( unsigned int subset(nextSubset(lines, size, 0)); subset != 0;
+            subset = nextSubset(lines, size, subset) )
+      {
+        unsigned int covered(0);
+        for ( unsigned int lineIter(subset); lineIter != 0; lineIter &= lineIter - 1 )
+        {
+          covered |= state_.places[base + __builtin_ctz(lineIter)][value - 1];
+        }
+
+        if ( countValues(covered) == size )
+        {
+          // The value is at size places in the base lines, all in the cover lines, so it cannot go
+          // anywhere else in the cover lines.
+          deduction = makeRemoval_(technique, valueToMask(value));
+          for ( unsigned int lineIter(covered); lineIter != 0; lineIter &= lineIter - 1 )
+          {
+            addRemovals_(cover + __builtin_ctz(lineIter), allValues & ~subset, deduction);
+          }
+          if ( ! isEmpty(deduction.gridPoints) )
+          {
+            deduction.unit = base;
+            for ( unsigned int lineIter(subset); lineIter != 0; lineIter &= lineIter - 1 )
+            {
+              const short line(static_cast<short>(base + __builtin_ctz(lineIter)));
+              deduction.pattern =
+                deduction.pattern | unitBits(line, state_.places[line][value - 1]);
+            }
+            return true;
+          }
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findXYWing_( Deduction_& deduction ) const
+{
+  for ( short pivot(0); pivot < Tables::numberOfGridPoints; ++pivot )
+  {
+    const ValueMask xy(state_.possible[pivot]);
+    if ( countValues(xy) != 2 )
+    {
+      continue;
+    }
+
+    const Tables::Index* peers(Tables::getPeers(pivot));
+    for ( short i(0); i < Tables::numberOfPeers; ++i )
+    {
+      // The first pincer has one of x and y, and a third value z.
+      const ValueMask xz(state_.possible[peers[i]]);
+      if ( countValues(xz) != 2 || countValues(xz & xy) != 1 )
+      {
+        continue;
+      }
+      const ValueMask z(xz & ~xy);
+      const ValueMask yz(( xy & ~xz ) | z);
+
+      for ( short j(i + 1); j < Tables::numberOfPeers; ++j )
+      {
+        if ( state_.possible[peers[j]] != yz )
+        {
+          continue;
+        }
+
+        // One of the pincers is z, so z cannot go at a grid point that sees both.
+        deduction = makeRemoval_(Technique::XYWing, z);
+        const Tables::Index* pincerPeers(Tables::getPeers(peers[i]));
+        for ( short k(0); k < Tables::numberOfPeers; ++k )
+        {
+          const short gridPoint(pincerPeers[k]);
+          if ( ( state_.possible[gridPoint] & z ) != 0 && gridPoint != peers[j] &&
+               Tables::sharesUnit(gridPoint, peers[j]) )
+          {
+            deduction.gridPoints = deduction.gridPoints | gridPointBits(gridPoint);
+          }
+        }
+        if ( ! isEmpty(deduction.gridPoints) )
+        {
+          deduction.pattern = gridPointBits(pivot) | gridPointBits(peers[i]) |
+            gridPointBits(peers[j]);
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuAssist::findSimpleChain_( Deduction_& deduction ) const
+{
+  short chain[Tables::numberOfGridPoints]; // The grid points of the chain, in the order found.
+  // The colours of chain n are 2n and 2n + 1, -1 if a grid point is not in a chain yet.
+  short colour[Tables::numberOfGridPoints];
+
+  for ( short value(1); value <= Tables::boardSize; ++value )
+  {
+    const ValueMask mask(valueToMask(value));
+    short first(0); // The first colour of the chain.
+    std::fill(colour, colour + Tables::numberOfGridPoints, -1);
+
+    for ( short start(0); start < Tables::numberOfGridPoints; ++start, first += 2 )
+    {
+      if ( ( state_.possible[start] & mask ) == 0 || colour[start] >= 0 )
+      {
+        continue;
+      }
+
+      // Colour the chain from start, the two grid points of a unit where the value can only go
+      // in two places have different colours, so exactly one of the colours is the value.
+      short length(0);
+      chain[length++] = start;
+      colour[start] = first;
+      for ( short next(0); next < length; ++next )
+      {
+        const short gridPoint(chain[next]);
+        const short* units(Tables::getUnitsOf(gridPoint));
+        for ( short which(0); which < 3; ++which )
+        {
+          const unsigned int positions(state_.places[units[which]][value - 1]);
+          if ( countValues(positions) != 2 )
+          {
+            continue;
+          }
+          const unsigned int other(positions & ~( 1u << getPosition(gridPoint, which) ));
+          const short linked(Tables::getUnit(units[which])[__builtin_ctz(other)]);
+          if ( colour[linked] < 0 )
+          {
+            colour[linked] = static_cast<short>(colour[gridPoint] ^ 1);
+            chain[length++] = linked;
+          }
+        }
+      }
+
+      if ( length < 2 )
+      {
+        continue;
+      }
+
+      deduction = makeRemoval_(Technique::SimpleChain, mask);
+
+      // If two grid points of a colour see each other that colour cannot be the value.
+      for ( short i(0); i < length && isEmpty(deduction.gridPoints); ++i )
+      {
+        for ( short j(i + 1); j < length; ++j )
+        {
+          if ( colour[chain[i]] == colour[chain[j]] && Tables::sharesUnit(chain[i], chain[j]) )
+          {
+            for ( short k(0); k < length; ++k )
+            {
+              if ( colour[chain[k]] == colour[chain[i]] )
+              {
+                deduction.gridPoints = deduction.gridPoints | gridPointBits(chain[k]);
+              }
+            }
+            break;
+          }
+        }
+      }
+
+      // Otherwise a grid point outside the chain that sees both colours cannot be the value.
+      for ( short gridPoint(0); gridPoint < Tables::numberOfGridPoints &&
+            isEmpty(deduction.gridPoints); ++gridPoint )
+      {
+        if ( ( state_.possible[gridPoint] & mask ) == 0 || colour[gridPoint] >= first )
+        {
+          continue;
+        }
+        bool sees[2] = { false, false };
+        for ( short i(0); i < length; ++i )
+        {
+          if ( Tables::sharesUnit(gridPoint, chain[i]) )
+          {
+            sees[colour[chain[i]] - first] = true;
+          }
+        }
+        if ( sees[0] && sees[1] )
+        {
+          deduction.gridPoints = gridPointBits(gridPoint);
+        }
+      }
+
+      if ( ! isEmpty(deduction.gridPoints) )
+      {
+        for ( short i(0); i < length; ++i )
+        {
+          deduction.pattern = deduction.pattern | gridPointBits(chain[i]);
+        }
+        return true;
+      }
+    }
+  }
+
+  return false;
 }
 
 } // End of namespace sudoku.
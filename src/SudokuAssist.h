@@ -6,27 +6,308 @@
 /// \author anon.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <string>
+
+#include "GridBits.h"
+#include "SudokuTables.h"
+#include "ValueMask.h"
+
 namespace sudoku
 {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief SudokuAssist contains methods for helping a user solve a Sudoku board.
+/// \brief The techniques SudokuAssist uses, from the easiest to the hardest.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class Technique
+{
+  None, // Nothing was needed, the board was already solved.
+  HiddenSingle, // A value can only go at one grid point of a unit.
+  NakedSingle, // A grid point can only have one value.
+  LockedCandidates, // A value in a box is only in one row or column, or the other way round.
+  NakedSubset, // N grid points of a unit can only have the same N values.
+  HiddenSubset, // N values of a unit can only go at the same N grid points.
+  XWing, // A value in two rows is only in the same two columns, or the other way round.
+  Swordfish, // As XWing, with three rows and columns.
+  XYWing, // A grid point with values xy sees grid points with xz and yz, so z is in one of them.
+  SimpleChain, // The grid points linked by a value being in only two places in their units.
+  Guessing // The techniques are not enough, a guess is needed or there is no solution.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A hint: the value to give a grid point next, and how it was found.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SudokuHint
+{
+  short x; // The row of the grid point.
+  short y; // The column of the grid point.
+  short value; // The value.
+  Technique technique; // The hardest technique used to find it.
+  std::string explanation; // Each deduction used, the last gives the value.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuAssist contains methods for helping a user solve a Sudoku board.  It solves 9x9
+/// boards as a person would, trying the techniques from the easiest to the hardest and going back
+/// to the easiest after each deduction, so how hard a board is can be rated by the hardest
+/// technique it needs.
+///
+/// The possible values of each grid point are held as a ValueMask, and for each unit and value the
+/// positions in the unit that can have the value are held as a mask too.  Both are updated as
+/// values are given and removed, so the singles, subsets and fish are found from the masks without
+/// rescanning the board.  The state is kept in the object, so an assist should be reused but not
+/// shared between threads.
+///
+/// An assist also holds a session in which a user solves a board, placing and erasing values, and
+/// asks for hints.  Placing or erasing a value only updates its peers.  A hint makes deductions on
+/// a copy of the state until one gives a value, so the session only holds the values placed.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 class SudokuAssist
 {
   public:
+    static const short numberOfTechniques = static_cast<short>(Technique::Guessing) + 1;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief SudokuAssist constructor.
     ////////////////////////////////////////////////////////////////////////////////////////////////
     SudokuAssist();
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves a board as far as the techniques go.
+    /// \param values The values row by row, 0 if the grid point has no value.
+    /// \param result Filled with the values found row by row, 0 where none was found.
+    /// \return true if the board was solved, false otherwise.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool solve( const short (&values)[SudokuTables::numberOfGridPoints],
+      short (&result)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Rates how hard a board is to solve by the techniques.
+    /// \param values The values row by row, 0 if the grid point has no value.
+    /// \return The hardest technique needed, Guessing if the techniques are not enough.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    Technique rate( const short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the hardest technique used by the last call to solve or rate.
+    /// \return The technique, Guessing if the board was not solved.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    Technique getHardestTechnique() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of deductions made with a technique by the last call to solve or
+    /// rate.
+    /// \param technique The technique.
+    /// \return The number of deductions.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned int getUses( Technique technique ) const
+    {
+      return uses_[static_cast<short>(technique)];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Starts a session on a board, ending any session in progress.  solve and rate also end
+    /// the session.
+    /// \param values The values row by row, 0 if the grid point has no value.  They cannot be
+    /// erased.
+    /// \return false if a value is given twice in a unit, true otherwise.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool start( const short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Places a value in the session.
+    /// \param x The row of the grid point.
+    /// \param y The column of the grid point.
+    /// \param value The value.
+    /// \return false if the grid point has a value or the value is already in its row, column or
+    /// box, true otherwise.
+    /// \throws invalid_argument If x, y or value is outside the range of the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool place( short x, short y, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Erases a value placed in the session.
+    /// \param x The row of the grid point.
+    /// \param y The column of the grid point.
+    /// \return false if the grid point has no value or it was given when the session started, true
+    /// otherwise.
+    /// \throws invalid_argument If x or y is outside the range of the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool erase( short x, short y );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the current values of the session.
+    /// \param values Filled with the values row by row, 0 if the grid point has no value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void getValues( short (&values)[SudokuTables::numberOfGridPoints] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the next value to place in the session with the easiest techniques, and
+    /// explains how.  The session is not changed.
+    /// \param hint Set to the hint.
+    /// \return false if the board is solved, has no solution given the values placed, or needs a
+    /// guess, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool nextHint( SudokuHint& hint );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the name of a technique.
+    /// \param technique The technique.
+    /// \return The name, for example "Hidden single".
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static const char* getTechniqueName( Technique technique );
+
+  /// Private types.
+  private:
+    // A deduction: either a value for a grid point, or values to remove from some grid points.
+    struct Deduction_
+    {
+      Technique technique; // The technique that found it.
+      short gridPoint; // The grid point given a value, -1 if values are removed.
+      short value; // The value given.
+      ValueMask values; // The values removed.
+      GridBits gridPoints; // The grid points they are removed from.
+      short unit; // The unit the technique looked at, or the first row or column of a fish.
+      GridBits pattern; // The grid points that show the deduction holds.
+    };
+
+    // The state of a board.
+    struct State_
+    {
+      short values[SudokuTables::numberOfGridPoints]; // The values, 0 if not given yet.
+      ValueMask possible[SudokuTables::numberOfGridPoints]; // Possible values, 0 once given.
+      // places[unit][value - 1]: the positions in the unit that can have the value, bit i for the
+      // grid point Tables::getUnit(unit)[i].  0 once the value is given in the unit.
+      unsigned short places[SudokuTables::numberOfUnits][SudokuTables::boardSize];
+      ValueMask given[SudokuTables::numberOfUnits]; // The values given in each unit.
+      ValueMask hiddenSingles[SudokuTables::numberOfUnits]; // Values with one position in a unit.
+      GridBits nakedSingles; // Grid points without a value that have one possible value.
+      // The grid points without a value that have nothing possible, and the values not given in a
+      // unit that cannot go anywhere in it.  The board has no solution unless this is 0.
+      short contradictions;
+      short unsolved; // The number of grid points without a value.
+    };
+
   /// Private Methods.
   private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes a deduction that removes values, from no grid points yet.
+    /// \param technique The technique.
+    /// \param values The values to remove.
+    /// \return The deduction.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static Deduction_ makeRemoval_( Technique technique, ValueMask values );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the grid point at x and y.
+    /// \param x The row.
+    /// \param y The column.
+    /// \return The grid point.
+    /// \throws invalid_argument If x or y is outside the range of the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static short getGridPoint_( short x, short y );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets up the state for a board and gives its values, and clears the uses.
+    /// \param values The values row by row, 0 if the grid point has no value.
+    /// \return false if a value is given twice in a unit, true otherwise.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool start_( const short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Applies the techniques, easiest first after every deduction, until the board is
+    /// solved or none of them finds anything.
+    /// \return true if the board was solved, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool run_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the deduction of the easiest technique that finds one.
+    /// \param deduction Set to the deduction.
+    /// \return true if a deduction was found, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool findDeduction_( Deduction_& deduction ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes a deduction.
+    /// \param deduction The deduction.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void apply_( const Deduction_& deduction );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives a grid point a value, removing the value from its peers.
+    /// \param gridPoint The grid point.
+    /// \param value The value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void place_( short gridPoint, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Removes a possible value from a grid point, and its position from its units, noting
+    /// any singles it leaves and whether it leaves the board with no solution.
+    /// \param gridPoint The grid point.
+    /// \param value The value, which may already have been removed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void removeValue_( short gridPoint, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Takes the value away from a grid point, making the values not in its units possible
+    /// for it, and its value possible for those of its peers that do not have it in their units.
+    /// \param gridPoint The grid point, which must have a value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void erase_( short gridPoint );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Puts back a possible value of a grid point without a value, and its position in its
+    /// units.  The value must not be given in any of its units.
+    /// \param gridPoint The grid point.
+    /// \param value The value, which may already be possible.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void restoreValue_( short gridPoint, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Describes a deduction for a person, using the state before it is made.
+    /// \param deduction The deduction.
+    /// \param description Has the description added.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void describe_( const Deduction_& deduction, std::string& description ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Adds the grid points at some positions of a unit that can have any of the values a
+    /// deduction removes to the grid points it removes them from.
+    /// \param unit The unit.
+    /// \param positions The positions, bit i for the grid point Tables::getUnit(unit)[i].
+    /// \param deduction The deduction.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void addRemovals_( short unit, unsigned int positions, Deduction_& deduction ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the positions in a unit of the grid points without a value.
+    /// \param unit The unit.
+    /// \return The positions.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned int getUnsolvedPositions_( short unit ) const;
+
+    // The techniques, each sets the deduction and returns true if it finds one.
+    bool findHiddenSingle_( Deduction_& deduction ) const;
+    bool findNakedSingle_( Deduction_& deduction ) const;
+    bool findLockedCandidates_( Deduction_& deduction ) const;
+    bool findNakedSubset_( short size, Deduction_& deduction ) const;
+    bool findHiddenSubset_( short size, Deduction_& deduction ) const;
+    bool findFish_( short size, Deduction_& deduction ) const;
+    bool findXYWing_( Deduction_& deduction ) const;
+    bool findSimpleChain_( Deduction_& deduction ) const;
 
   /// Private variables.
   private:
+    State_ state_; // The board being solved, or the session.
+    GridBits fixed_; // The grid points whose values were given when the session started.
+    bool solved_; // Whether the last call to solve or rate solved the board.
+    unsigned int uses_[numberOfTechniques]; // The deductions made with each technique.
 };
- 
+
 } // End of namespace sudoku.
 
 #endif
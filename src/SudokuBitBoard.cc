@@ -0,0 +1,318 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of SudokuBitBoard.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SudokuBitBoard.h"
+
+namespace sudoku
+{
+
+const SudokuBitBoard::Masks_ SudokuBitBoard::masks_ = SudokuBitBoard::makeMasks_();
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuBitBoard::SudokuBitBoard()
+  : guesses_(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuBitBoard::solve( const short (&values)[SudokuTables::numberOfGridPoints],
+  short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  return start_(values) && search_(1, solution) == 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SudokuBitBoard::countSolutions(
+  const short (&values)[SudokuTables::numberOfGridPoints], unsigned long limit )
+{
+  short solution[SudokuTables::numberOfGridPoints];
+  return countSolutions(values, limit, solution);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SudokuBitBoard::countSolutions(
+  const short (&values)[SudokuTables::numberOfGridPoints], unsigned long limit,
+  short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  if ( limit == 0 || ! start_(values) )
+  {
+    return 0;
+  }
+
+  return search_(limit, solution);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuBitBoard::start_( const short (&values)[SudokuTables::numberOfGridPoints] )
+{
+  State_& start(states_[0]);
+  for ( short value(0); value < SudokuTables::boardSize; ++value )
+  {
+    start.possible[value] = masks_.all;
+  }
+  start.unsolved = masks_.all;
+  guesses_ = 0;
+
+  // Clashing values leave a grid point with no possible values, which propagate_ finds.
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( values[i] != 0 )
+    {
+      place_(start, i, values[i]);
+    }
+  }
+  return propagate_(start);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+unsigned long SudokuBitBoard::search_( unsigned long limit,
+  short (&solution)[SudokuTables::numberOfGridPoints] )
+{
+  unsigned long solutions(0);
+  short depth(0);
+  bool descend(true);
+
+  while ( true )
+  {
+    if ( descend && isEmpty(states_[depth].unsolved) )
+    {
+      if ( solutions == 0 )
+      {
+        // Every grid point is left with just the bit for its value.
+        for ( short value(0); value < SudokuTables::boardSize; ++value )
+        {
+          for ( GridBits bits(states_[depth].possible[value]); ! isEmpty(bits); )
+          {
+            const short gridPoint(lowestGridPoint(bits));
+            solution[gridPoint] = value + 1;
+            bits = andNot(bits, masks_.gridPoint[gridPoint]);
+          }
+        }
+      }
+
+      // Carry on from the last guess as if the solution was a dead end.
+      if ( ++solutions == limit || depth == 0 )
+      {
+        return solutions;
+      }
+      --depth;
+      descend = false;
+      continue;
+    }
+
+    if ( descend )
+    {
+      guessGridPoint_[depth] = getMostConstrainedGridPoint_(states_[depth]);
+      untried_[depth] = getPossibleValues_(states_[depth], guessGridPoint_[depth]);
+    }
+
+    if ( untried_[depth] == 0 )
+    {
+      if ( depth == 0 )
+      {
+        return solutions;
+      }
+      --depth;
+      descend = false;
+      continue;
+    }
+
+    const short value(lowestValue(untried_[depth]));
+    untried_[depth] &= untried_[depth] - 1;
+    ++guesses_;
+
+    states_[depth + 1] = states_[depth];
+    place_(states_[depth + 1], guessGridPoint_[depth], value);
+    descend = propagate_(states_[depth + 1]);
+    if ( descend )
+    {
+      ++depth;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuBitBoard::Masks_ SudokuBitBoard::makeMasks_()
+{
+  Masks_ masks;
+  const short numberOfGridPoints(SudokuTables::numberOfGridPoints);
+
+  masks.all = makeGridBits(~static_cast<std::uint64_t>(0),
+    ( static_cast<std::uint64_t>(1) << ( numberOfGridPoints - 64 ) ) - 1);
+
+  for ( short gridPoint(0); gridPoint < numberOfGridPoints; ++gridPoint )
+  {
+    masks.gridPoint[gridPoint] = gridPoint < 64 ?
+      makeGridBits(static_cast<std::uint64_t>(1) << gridPoint, 0) :
+      makeGridBits(0, static_cast<std::uint64_t>(1) << ( gridPoint - 64 ));
+  }
+
+  for ( short gridPoint(0); gridPoint < numberOfGridPoints; ++gridPoint )
+  {
+    masks.peers[gridPoint] = makeGridBits(0, 0);
+    for ( short i(0); i < SudokuTables::numberOfPeers; ++i )
+    {
+      masks.peers[gridPoint] = masks.peers[gridPoint] |
+        masks.gridPoint[SudokuTables::getPeers(gridPoint)[i]];
+    }
+  }
+
+  for ( short unit(0); unit < SudokuTables::numberOfUnits; ++unit )
+  {
+    masks.units[unit] = makeGridBits(0, 0);
+    for ( short i(0); i < SudokuTables::boardSize; ++i )
+    {
+      masks.units[unit] = masks.units[unit] | masks.gridPoint[SudokuTables::getUnit(unit)[i]];
+    }
+  }
+
+  return masks;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoard::place_( State_& state, short gridPoint, short value )
+{
+  const GridBits& bit(masks_.gridPoint[gridPoint]);
+
+  for ( short other(0); other < SudokuTables::boardSize; ++other )
+  {
+    state.possible[other] = andNot(state.possible[other], bit);
+  }
+  state.possible[value - 1] = andNot(state.possible[value - 1], masks_.peers[gridPoint]) | bit;
+  state.unsolved = andNot(state.unsolved, bit);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuBitBoard::propagate_( State_& state )
+{
+  bool changed(true);
+
+  while ( changed )
+  {
+    changed = false;
+
+    // Count the possible values of every grid point at once: atLeastOne and atLeastTwo hold the
+    // grid points with at least one and at least two possible values.
+    GridBits atLeastOne(state.possible[0]);
+    GridBits atLeastTwo(makeGridBits(0, 0));
+    for ( short value(1); value < SudokuTables::boardSize; ++value )
+    {
+      atLeastTwo = atLeastTwo | ( atLeastOne & state.possible[value] );
+      atLeastOne = atLeastOne | state.possible[value];
+    }
+
+    if ( ! ( atLeastOne == masks_.all ) )
+    {
+      return false;
+    }
+
+    // Naked singles.
+    for ( GridBits singles(andNot(state.unsolved, atLeastTwo)); ! isEmpty(singles); )
+    {
+      const short gridPoint(lowestGridPoint(singles));
+      singles = andNot(singles, masks_.gridPoint[gridPoint]);
+
+      // An earlier single in the same unit may have taken the value.
+      const ValueMask possibleValues(getPossibleValues_(state, gridPoint));
+      if ( possibleValues == 0 )
+      {
+        return false;
+      }
+      place_(state, gridPoint, lowestValue(possibleValues));
+      changed = true;
+    }
+
+    if ( changed )
+    {
+      continue;
+    }
+
+    // Hidden singles, and values with nowhere to go.
+    for ( short value(0); value < SudokuTables::boardSize; ++value )
+    {
+      if ( isEmpty(state.possible[value] & state.unsolved) )
+      {
+        continue;
+      }
+
+      for ( short unit(0); unit < SudokuTables::numberOfUnits; ++unit )
+      {
+        const GridBits inUnit(state.possible[value] & masks_.units[unit]);
+
+        if ( isEmpty(inUnit) )
+        {
+          return false;
+        }
+        if ( hasOneBit(inUnit) && ! isEmpty(inUnit & state.unsolved) )
+        {
+          place_(state, lowestGridPoint(inUnit), value + 1);
+          changed = true;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuBitBoard::getMostConstrainedGridPoint_( const State_& state )
+{
+  GridBits atLeast[4] = { makeGridBits(0, 0), makeGridBits(0, 0), makeGridBits(0, 0),
+                          makeGridBits(0, 0) };
+
+  for ( short value(0); value < SudokuTables::boardSize; ++value )
+  {
+    atLeast[3] = atLeast[3] | ( atLeast[2] & state.possible[value] );
+    atLeast[2] = atLeast[2] | ( atLeast[1] & state.possible[value] );
+    atLeast[1] = atLeast[1] | ( atLeast[0] & state.possible[value] );
+    atLeast[0] = atLeast[0] | state.possible[value];
+  }
+
+  const GridBits two(andNot(atLeast[1], atLeast[2]) & state.unsolved);
+  if ( ! isEmpty(two) )
+  {
+    return lowestGridPoint(two);
+  }
+
+  const GridBits three(andNot(atLeast[2], atLeast[3]) & state.unsolved);
+  if ( ! isEmpty(three) )
+  {
+    return lowestGridPoint(three);
+  }
+
+  // Rare, a nearly empty board.  Look at each unsolved grid point.
+  short best(lowestGridPoint(state.unsolved));
+  for ( GridBits bits(state.unsolved); ! isEmpty(bits); )
+  {
+    const short gridPoint(lowestGridPoint(bits));
+    bits = andNot(bits, masks_.gridPoint[gridPoint]);
+    if ( countValues(getPossibleValues_(state, gridPoint)) <
+         countValues(getPossibleValues_(state, best)) )
+    {
+      best = gridPoint;
+    }
+  }
+
+  return best;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+ValueMask SudokuBitBoard::getPossibleValues_( const State_& state, short gridPoint )
+{
+  ValueMask possibleValues(0);
+
+  for ( short value(0); value < SudokuTables::boardSize; ++value )
+  {
+    if ( hasGridPoint(state.possible[value], gridPoint) )
+    {
+      possibleValues |= valueToMask(value + 1);
+    }
+  }
+
+  return possibleValues;
+}
+
+} // End of namespace sudoku.
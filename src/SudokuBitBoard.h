@@ -0,0 +1,157 @@
+#ifndef __sudoku_sudokubitboard_h__
+#define __sudoku_sudokubitboard_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SudokuBitBoard.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GridBits.h"
+#include "SudokuTables.h"
+#include "ValueMask.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuBitBoard solves a 9x9 Sudoku board held as nine planes of GridBits, one per value,
+/// where a bit is set if the grid point can still have the value.  Giving a grid point a value
+/// removes it from its peers with one and not per plane, and the naked and hidden singles of the
+/// whole board are found with a few ands and ors rather than by visiting grid points.  Guesses are
+/// made on copies of the planes, so backtracking is just going back to the previous copy.  The
+/// copies are allocated with the object, so an object should be reused for many boards.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuBitBoard
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief SudokuBitBoard constructor.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuBitBoard();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves a Sudoku board.
+    /// \param values The values of the grid points row by row, 0 if the grid point has no value.
+    /// \param solution Filled with the solution row by row, if there is one.
+    /// \return true if a solution was found, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool solve( const short (&values)[SudokuTables::numberOfGridPoints],
+      short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Counts the solutions of a Sudoku board, stopping once limit solutions are found.  A
+    /// limit of 2 checks whether the board has exactly one solution.
+    /// \param values The values of the grid points row by row, 0 if the grid point has no value.
+    /// \param limit The maximum number of solutions to count.
+    /// \return The number of solutions, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long countSolutions( const short (&values)[SudokuTables::numberOfGridPoints],
+      unsigned long limit );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief As countSolutions, but also gives the first solution found.
+    /// \param values The values of the grid points row by row, 0 if the grid point has no value.
+    /// \param limit The maximum number of solutions to count.
+    /// \param solution Filled with the first solution row by row, if there is one.
+    /// \return The number of solutions, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long countSolutions( const short (&values)[SudokuTables::numberOfGridPoints],
+      unsigned long limit, short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of guesses made by the last call to solve or countSolutions.
+    /// \return The number of guesses.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getGuesses() const
+    {
+      return guesses_;
+    }
+
+  /// Private types and methods.
+  private:
+    // Struct holding the state of the board.  A grid point with a value keeps only the bit for
+    // that value, so a value placed twice in a unit leaves a grid point with no bits.
+    struct State_
+    {
+      GridBits possible[SudokuTables::boardSize]; // possible[v - 1]: grid points that can be v.
+      GridBits unsolved; // Grid points without a value.
+    };
+
+    // Struct holding the GridBits used to update a State_.
+    struct Masks_
+    {
+      GridBits all; // Every grid point.
+      GridBits gridPoint[SudokuTables::numberOfGridPoints]; // Each grid point on its own.
+      GridBits peers[SudokuTables::numberOfGridPoints]; // The peers of each grid point.
+      GridBits units[SudokuTables::numberOfUnits]; // The grid points in each unit.
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Builds the masks from SudokuTables.
+    /// \return The masks.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static Masks_ makeMasks_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Sets states_[0] to the board with the given values and the values they force.
+    /// \param values The values of the grid points row by row, 0 if the grid point has no value.
+    /// \return false if the values leave the board with no solution, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool start_( const short (&values)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Searches from states_[0], stopping once limit solutions are found.
+    /// \param limit The maximum number of solutions to find, at least 1.
+    /// \param solution Filled with the first solution found, if there is one.
+    /// \return The number of solutions found, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long search_( unsigned long limit,
+      short (&solution)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives a grid point a value, removing the value from its peers.
+    /// \param state The state to change.
+    /// \param gridPoint The grid point.
+    /// \param value The value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void place_( State_& state, short gridPoint, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives values to naked and hidden singles until there are none left.
+    /// \param state The state to change.
+    /// \return false if a grid point has no possible values or a value has nowhere to go in a
+    /// unit, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static bool propagate_( State_& state );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the unsolved grid point with the fewest possible values, preferring grid points
+    /// with two or three possible values.
+    /// \param state The state, which must have an unsolved grid point.
+    /// \return The grid point.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static short getMostConstrainedGridPoint_( const State_& state );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the possible values of a grid point.
+    /// \param state The state.
+    /// \param gridPoint The grid point.
+    /// \return The possible values.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static ValueMask getPossibleValues_( const State_& state, short gridPoint );
+
+  /// Private variables.
+  private:
+    static const Masks_ masks_; // The masks, shared by every object.
+
+    // states_[0] is the board after the given values, states_[d + 1] is states_[d] after the
+    // guess in guessGridPoint_[d].
+    State_ states_[SudokuTables::numberOfGridPoints + 1];
+    short guessGridPoint_[SudokuTables::numberOfGridPoints]; // Grid point guessed at each depth.
+    ValueMask untried_[SudokuTables::numberOfGridPoints]; // Values not yet guessed at each depth.
+    unsigned long guesses_; // Number of guesses made by the last solve or count.
+};
+ 
+} // End of namespace sudoku.
+
+#endif
@@ -1,206 +1,981 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief Implementation of SudokuBoard.
+/// \brief Implementation of BasicSudokuBoard.
 /// \author anon.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "SudokuBoard.h"
+#include "WorkStealingPool.h"
 
 namespace sudoku
 {
 
+template<short BoxSize>
+const typename BasicSudokuBoard<BoxSize>::Index_ BasicSudokuBoard<BoxSize>::noGridPoint_;
+template<short BoxSize>
+const unsigned long BasicSudokuBoard<BoxSize>::cancelCheckGuesses_;
+template<short BoxSize>
+const unsigned int BasicSudokuBoard<BoxSize>::maxSplitDepth_;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+short BasicSudokuBoard<BoxSize>::decodeValue_( short value, short index )
+{
+  if ( value < 0 )
+  {
+    throw std::invalid_argument("Grid point (" + std::to_string(index / boardSize) + "," +
+      std::to_string(index % boardSize) + ") has value < 0");
+  }
+  if ( value > boardSize )
+  {
+    throw std::invalid_argument("Grid point (" + std::to_string(index / boardSize) + "," +
+      std::to_string(index % boardSize) + ") has value > " + std::to_string(boardSize));
+  }
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+short BasicSudokuBoard<BoxSize>::decodeValue_( std::uint8_t value, short index )
+{
+  return decodeValue_(static_cast<short>(value), index);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+short BasicSudokuBoard<BoxSize>::decodeValue_( char character, short index )
+{
+  short value(boardSize + 1);
+  if ( character == '.' )
+  {
+    value = 0;
+  }
+  else if ( character >= '0' && character <= '9' )
+  {
+    value = static_cast<short>(character - '0');
+  }
+  else if ( character >= 'A' && character <= 'Z' )
+  {
+    value = static_cast<short>(character - 'A' + 10);
+  }
+  else if ( character >= 'a' && character <= 'z' )
+  {
+    value = static_cast<short>(character - 'a' + 10);
+  }
+
+  if ( value > boardSize )
+  {
+    throw std::invalid_argument("Grid point (" + std::to_string(index / boardSize) + "," +
+      std::to_string(index % boardSize) + ") has character '" + std::string(1, character) + "'");
+  }
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+template<typename Value>
+void BasicSudokuBoard<BoxSize>::populate_( const Value* values )
+{
+  StatisticsTimer timer(statistics_.populateNanoseconds);
+
+  // Check the values and count them in their row, column and box.
+  for ( short i(0); i < numberOfGridPoints; ++i )
+  {
+    const short value(decodeValue_(values[i], i));
+    if ( value > 0 )
+    {
+      const short* units(Tables::getUnitsOf(i));
+      for ( short which(0); which < 3; ++which )
+      {
+        if ( ++valueCounts_[units[which]][value - 1] == 2 )
+        {
+          // The value is in the unit twice, so the board is invalid.
+          ++duplicates_;
+        }
+        unitValues_[units[which]] |= valueToMask(value);
+      }
+      sudokuBoard_[i] = GridPoint(i / boardSize, i % boardSize, value);
+    }
+  }
+  validBoard_ = duplicates_ == 0;
+
+  // The possible values of a grid point without a value are those not in its units.
+  for ( short i(0); i < numberOfGridPoints; ++i )
+  {
+    if ( sudokuBoard_[i].getValue() == 0 )
+    {
+      const short* units(Tables::getUnitsOf(i));
+      const ValueMask possibleValues(allValuesMask(boardSize) &
+        ~( unitValues_[units[0]] | unitValues_[units[1]] | unitValues_[units[2]] ));
+
+      sudokuBoard_[i] = GridPoint(i / boardSize, i % boardSize, 1);
+      sudokuBoard_[i].resetPossibleValues(possibleValues);
+      moveBetweenBuckets_(i, 0, countValues(possibleValues));
+      deadGridPoints_ += possibleValues == 0 ? 1 : 0;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::place( short x, short y, short value )
+{
+  // Let this do the work of checking x, y and the value.
+  const GridPoint placed(x, y, value);
+  const Index_ index(static_cast<Index_>(x * boardSize + y));
+
+  resetSearch_();
+  if ( sudokuBoard_[index].getValue() != 0 )
+  {
+    erase_(index);
+  }
+
+  const ValueMask valueMask(valueToMask(value));
+  const short* units(Tables::getUnitsOf(index));
+  bool clash(false);
+  for ( short which(0); which < 3; ++which )
+  {
+    const short unit(units[which]);
+    clash = clash || ( unitValues_[unit] & valueMask ) != 0;
+    if ( ++valueCounts_[unit][value - 1] == 2 )
+    {
+      ++duplicates_;
+    }
+    unitValues_[unit] |= valueMask;
+  }
+  validBoard_ = duplicates_ == 0;
+
+  // The grid point has no value now, so it is in a bucket unless it has no possible values.
+  const ValueMask possibleValues(sudokuBoard_[index].getPossibleValuesMask());
+  moveBetweenBuckets_(index, countValues(possibleValues), 0);
+  deadGridPoints_ -= possibleValues == 0 ? 1 : 0;
+  sudokuBoard_[index] = placed;
+
+  const typename Tables::Index* peers(Tables::getPeers(index));
+  for ( short i(0); i < Tables::numberOfPeers; ++i )
+  {
+    const ValueMask peerValues(sudokuBoard_[peers[i]].getPossibleValuesMask());
+    if ( ( peerValues & valueMask ) != 0 )
+    {
+      setPossibleValues_(peers[i], peerValues & ~valueMask);
+    }
+  }
+
+  return ! clash;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::erase( short x, short y )
+{
+  // Let this do the work of checking the bounds of x and y.
+  GridPoint check(x, y, 1);
+  const Index_ index(static_cast<Index_>(x * boardSize + y));
+
+  resetSearch_();
+  if ( sudokuBoard_[index].getValue() == 0 )
+  {
+    return false;
+  }
+
+  erase_(index);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::solveBoard()
+{
+  (void)searchBoard();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::solveBoard( SolverEngine engine )
+{
+  // The solvers are big, so keep one of each per thread and reuse it.
+  if ( engine == SolverEngine::DancingLinks )
+  {
+    static thread_local BasicDancingLinks<BoxSize> dancingLinks;
+    solveWith_(dancingLinks);
+  }
+  else if ( engine == SolverEngine::BitBoard )
+  {
+    solveWithBitBoard_();
+  }
+  else
+  {
+    solveBoard();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+typename BasicSudokuBoard<BoxSize>::SearchState BasicSudokuBoard<BoxSize>::solveBoard(
+  const SolveLimits& limits )
+{
+  SearchState state(searchBoard(0));
+
+  // Search a few guesses at a time, checking the limits in between.
+  while ( state == SearchState::Paused )
+  {
+    if ( searchGuesses_ >= limits.maxGuesses ||
+         ( limits.cancelled != nullptr && *limits.cancelled ) ||
+         ( limits.deadline != SolveLimits::Clock::time_point::max() &&
+           SolveLimits::Clock::now() >= limits.deadline ) )
+    {
+      // Undo the guesses, but keep the count of them.
+      const unsigned long guesses(searchGuesses_);
+      resetSearch_();
+      searchGuesses_ = guesses;
+      searchState_ = SearchState::Aborted;
+      return searchState_;
+    }
+    state = search_(std::min(cancelCheckGuesses_, limits.maxGuesses - searchGuesses_));
+  }
+
+  return state;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SudokuBoard::checkBoardValues_( const short (&initialBoard)[9][9] ) const
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::solveWithBitBoard_()
 {
-  for ( unsigned short i(0); i < sizeof(initialBoard)/sizeof(*initialBoard); ++i )
+  throw std::invalid_argument("The bit board engine can only solve 9x9 boards.");
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<>
+void BasicSudokuBoard<3>::solveWithBitBoard_()
+{
+  static thread_local SudokuBitBoard bitBoard;
+  solveWith_(bitBoard);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::solveBoardInParallel( unsigned int numberOfThreads )
+{
+  if ( ! isConsistent() )
   {
-    for ( unsigned short j(0); j < sizeof(initialBoard[i])/sizeof(*initialBoard[i]); ++j )
+    searchState_ = SearchState::Exhausted;
+  }
+  if ( searchState_ == SearchState::Solved || searchState_ == SearchState::Exhausted )
+  {
+    return;
+  }
+
+  // Abandon any paused search.
+  resetSearch_();
+
+  short solution[numberOfGridPoints];
+  finishSolve_(searchInParallel_(1, numberOfThreads, solution) == 1, solution);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+typename BasicSudokuBoard<BoxSize>::SearchState BasicSudokuBoard<BoxSize>::searchBoard(
+  unsigned long maxGuesses )
+{
+  if ( searchState_ == SearchState::Aborted )
+  {
+    // Start again, the aborted search was undone.
+    searchState_ = SearchState::NotStarted;
+  }
+  if ( searchState_ == SearchState::NotStarted )
+  {
+    resetStatistics_();
+  }
+  return search_(maxGuesses);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+typename BasicSudokuBoard<BoxSize>::SearchState BasicSudokuBoard<BoxSize>::search_(
+  unsigned long maxGuesses )
+{
+  // If the board is not consistent we cannot solve it!
+  if ( ! isConsistent() )
+  {
+    searchState_ = SearchState::Exhausted;
+  }
+
+  if ( searchState_ == SearchState::Solved || searchState_ == SearchState::Exhausted )
+  {
+    return searchState_;
+  }
+
+  StatisticsTimer timer(statistics_.searchNanoseconds);
+
+  if ( searchState_ == SearchState::NotStarted && ! propagate_() )
+  {
+    // The forced values leave something with nowhere to go.
+    undoTrail_(0);
+    searchState_ = SearchState::Exhausted;
+    return searchState_;
+  }
+
+  unsigned long guesses(0);
+
+  while ( true )
+  {
+    if ( searchDescend_ )
     {
-      if ( initialBoard[i][j] < 0 )
+      // Look for a solved board first, the forced values may have filled it without a guess.
+      const Index_ gpIndex(getMostConstrainedGridPoint_());
+
+      if ( gpIndex == noGridPoint_ )
+      {
+        // Every grid point has a value.  We have solved it!
+        boardSolvable_ = true;
+        searchState_ = SearchState::Solved;
+        break;
+      }
+
+      if ( guesses == maxGuesses )
       {
-        throw std::invalid_argument("Grid point (" + std::to_string(i) + "," + std::to_string(j) +
-          ") has value < 0");
+        // Pause with every guess on the stack on the board.
+        searchState_ = SearchState::Paused;
+        break;
       }
-      if ( initialBoard[i][j] > 9 )
+
+      // Guess a value for the grid point with the fewest possible values.
+      SearchFrame_& frame(searchStack_[searchDepth_++]);
+      frame.index = gpIndex;
+      frame.untried = sudokuBoard_[gpIndex].getPossibleValuesMask();
+      frame.mark = trailSize_;
+      searchDescend_ = false;
+
+      if ( SearchStatistics::enabled )
       {
-        throw std::invalid_argument("Grid point (" + std::to_string(i) + "," + std::to_string(j) +
-          ") has value > 9");
+        ++statistics_.nodes;
+        statistics_.maxDepth = std::max(statistics_.maxDepth, searchDepth_);
       }
     }
+
+    if ( searchDepth_ == 0 )
+    {
+      // Every guess failed, also undo the values forced before the first guess.
+      undoTrail_(0);
+      searchState_ = SearchState::Exhausted;
+      break;
+    }
+
+    // Return the board to how it was before the last guess at this depth.
+    SearchFrame_& frame(searchStack_[searchDepth_ - 1]);
+    undoTrail_(frame.mark);
+
+    if ( frame.untried == 0 )
+    {
+      // No values left to guess here, the guess before this one was wrong.
+      --searchDepth_;
+
+      if ( SearchStatistics::enabled )
+      {
+        ++statistics_.backtracks;
+      }
+    }
+    else if ( guesses == maxGuesses )
+    {
+      // Pause with the last guess undone, it will be replaced by the next value when resumed.
+      searchState_ = SearchState::Paused;
+      break;
+    }
+    else
+    {
+      const short val(lowestValue(frame.untried));
+      frame.untried &= frame.untried - 1;
+      ++guesses;
+      ++searchGuesses_;
+
+      if ( SearchStatistics::enabled )
+      {
+        ++statistics_.guesses;
+      }
+
+      // If the guess, or the values it forces, leaves something with nowhere to go try the next
+      // value, otherwise carry on to the next grid point.
+      searchDescend_ = assignValue_(frame.index, val) && propagate_();
+    }
+  }
+
+  return searchState_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+unsigned long BasicSudokuBoard<BoxSize>::countSolutions( unsigned long limit )
+{
+  unsigned long solutions(0);
+
+  resetSearch_();
+  resetStatistics_();
+  while ( solutions < limit && nextSolution_() )
+  {
+    ++solutions;
+  }
+  resetSearch_();
+
+  return solutions;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+unsigned long BasicSudokuBoard<BoxSize>::countSolutionsInParallel( unsigned long limit,
+  unsigned int numberOfThreads )
+{
+  short solution[numberOfGridPoints];
+
+  resetSearch_();
+  return searchInParallel_(limit, numberOfThreads, solution);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+unsigned long BasicSudokuBoard<BoxSize>::visitSolutions( const SolutionVisitor& visitor )
+{
+  unsigned long solutions(0);
+  SolutionGrid grid;
+  bool carryOn(true);
+
+  resetSearch_();
+  resetStatistics_();
+  while ( carryOn && nextSolution_() )
+  {
+    for ( short i(0); i < numberOfGridPoints; ++i )
+    {
+      grid[i] = static_cast<unsigned char>(sudokuBoard_[i].getValue());
+    }
+    ++solutions;
+    carryOn = visitor(grid);
   }
+  resetSearch_();
+
+  return solutions;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SudokuBoard::populateSudokuBoard_( const short (&initialBoard)[9][9] )
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::erase_( Index_ index )
 {
-  for ( unsigned short gridX(0); gridX < 9; ++gridX )
+  const short value(sudokuBoard_[index].getValue());
+  const ValueMask valueMask(valueToMask(value));
+  const short* units(Tables::getUnitsOf(index));
+  for ( short which(0); which < 3; ++which )
+  {
+    const short unit(units[which]);
+    const unsigned char count(--valueCounts_[unit][value - 1]);
+    if ( count == 1 )
+    {
+      --duplicates_;
+    }
+    else if ( count == 0 )
+    {
+      unitValues_[unit] &= ~valueMask;
+    }
+  }
+  validBoard_ = duplicates_ == 0;
+
+  // The grid point can have the values not in its units.  With a value it was in no bucket.
+  const ValueMask possibleValues(allValuesMask(boardSize) &
+    ~( unitValues_[units[0]] | unitValues_[units[1]] | unitValues_[units[2]] ));
+  sudokuBoard_[index].resetPossibleValues(possibleValues);
+  moveBetweenBuckets_(index, 0, countValues(possibleValues));
+  deadGridPoints_ += possibleValues == 0 ? 1 : 0;
+
+  // The value is possible again for the peers without a value that do not have it in a unit.
+  const typename Tables::Index* peers(Tables::getPeers(index));
+  for ( short i(0); i < Tables::numberOfPeers; ++i )
   {
-    for ( unsigned short gridY(0); gridY < 9; ++gridY )
+    const GridPoint& peer(sudokuBoard_[peers[i]]);
+    const short* peerUnits(Tables::getUnitsOf(peers[i]));
+    if ( peer.getValue() == 0 && ( ( unitValues_[peerUnits[0]] | unitValues_[peerUnits[1]] |
+         unitValues_[peerUnits[2]] ) & valueMask ) == 0 )
     {
-      if ( initialBoard[gridX][gridY] > 0 )
+      setPossibleValues_(peers[i], peer.getPossibleValuesMask() | valueMask);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::setPossibleValues_( Index_ index, ValueMask possibleValues )
+{
+  const short oldNumber(sudokuBoard_[index].getNumberOfPossibleValues());
+  const short newNumber(countValues(possibleValues));
+
+  sudokuBoard_[index].resetPossibleValues(possibleValues);
+  moveBetweenBuckets_(index, oldNumber, newNumber);
+  deadGridPoints_ += ( newNumber == 0 ? 1 : 0 ) - ( oldNumber == 0 ? 1 : 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::assignValue_( Index_ index, short value )
+{
+  const ValueMask otherValues(sudokuBoard_[index].getPossibleValuesMask() & ~valueToMask(value));
+
+  for ( ValueMask otherIter(otherValues); otherIter != 0; otherIter &= otherIter - 1 )
+  {
+    // Remove the other possible values.
+    removePossibleValue_(index, lowestValue(otherIter));
+  }
+  // Now remove the value itself to add it as a guess.
+  removePossibleValue_(index, value);
+
+  // Remove the value from the peers that are not solved yet.
+  const ValueMask valueMask(valueToMask(value));
+  const typename Tables::Index* peers(Tables::getPeers(index));
+  for ( short i(0); i < Tables::numberOfPeers; ++i )
+  {
+    const ValueMask peerValues(sudokuBoard_[peers[i]].getPossibleValuesMask());
+    if ( ( peerValues & valueMask ) != 0 )
+    {
+      if ( peerValues == valueMask )
       {
-        // We have an initial value specified.
-        sudokuBoard_.push_back(SudokuGridPoint(gridX, gridY, initialBoard[gridX][gridY]));
+        // We would remove the last value at another grid point, the value is not valid.
+        return false;
       }
-      else
+      removePossibleValue_(peers[i], value);
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::propagate_()
+{
+  StatisticsTimer timer(statistics_.propagateNanoseconds);
+  const ValueMask allValues(allValuesMask(boardSize));
+  bool changed(true);
+
+  while ( changed )
+  {
+    changed = false;
+
+    // Naked singles are the grid points in the bucket with one possible value.
+    while ( bucketHead_[1] != noGridPoint_ )
+    {
+      const Index_ index(bucketHead_[1]);
+      if ( SearchStatistics::enabled )
+      {
+        ++statistics_.propagations;
+      }
+      if ( ! assignValue_(index, lowestValue(sudokuBoard_[index].getPossibleValuesMask())) )
       {
-        // The value was 0, no initial value specified.
+        return false;
+      }
+    }
 
-        // Explicitly define result array to be zeroes.
-        short rowValues[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-        short columnValues[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
-        short squareValues[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };        
+    // Hidden singles are the values that only one grid point in a unit can have.
+    for ( short unit(0); unit < Tables::numberOfUnits && ! changed; ++unit )
+    {
+      const typename Tables::Index* gridPoints(Tables::getUnit(unit));
+      ValueMask once(0); // Values possible for at least one grid point.
+      ValueMask twice(0); // Values possible for at least two grid points.
+      ValueMask placed(0); // Values already given to a grid point.
 
-        std::vector<short> possibleValuesVector;
-      
-        // Add to arrays based on numbers in row and column of coordinate (x,y).
-        for ( short i(0); i < 9; ++i )
+      for ( short i(0); i < boardSize; ++i )
+      {
+        const GridPoint& sgp(sudokuBoard_[gridPoints[i]]);
+        const ValueMask possibleValues(sgp.getPossibleValuesMask());
+        if ( possibleValues == 0 )
         {
-          if ( initialBoard[gridX][i] > 0 && i != gridY )
-          {
-            ++rowValues[initialBoard[gridX][i] - 1];
-          }
-          if ( initialBoard[i][gridY] > 0 && i != gridX )
-          {
-            ++columnValues[initialBoard[i][gridY] - 1];
-          }
+          placed |= valueToMask(sgp.getValue());
         }
-      
-        // Get the top left corner of the square the coordinate (x,y) is in.
-        short startX = gridX - (gridX % 3);
-        short startY = gridY - (gridY % 3);
-      
-        for ( short i(startX); i < startX + 3; ++i )
+        twice |= once & possibleValues;
+        once |= possibleValues;
+      }
+
+      if ( ( once | placed ) != allValues )
+      {
+        // A value cannot go anywhere in the unit.
+        return false;
+      }
+
+      const ValueMask singles(once & ~twice & ~placed);
+      if ( singles != 0 )
+      {
+        const short value(lowestValue(singles));
+        short i(0);
+        while ( ! sudokuBoard_[gridPoints[i]].hasPossibleValue(value) )
         {
-          for ( short j(startY); j < startY + 3; ++j )
-          {
-            if ( initialBoard[i][j] > 0 && i != gridX && j != gridY )
-            {
-              ++squareValues[initialBoard[i][j] - 1];
-            }
-          }
+          ++i;
         }
-      
-        // Now to check the row, column and square values to make sure the values are no greater
-        // than 1, otherwise the board is invalid.
-        for ( short i(0); i < 9; ++i )
+        if ( SearchStatistics::enabled )
         {
-          if ( rowValues[i] > 1 || columnValues[i] > 1 || squareValues[i] > 1 )
-          {
-            validBoard_ = false;
-          }
+          ++statistics_.propagations;
         }
-
-        // Add values to result vector.
-        for ( short i(0); i < 9; ++i )
+        if ( ! assignValue_(gridPoints[i], value) )
         {
-          if ( rowValues[i] + columnValues[i] + squareValues[i] == 0 )
-          {
-            possibleValuesVector.push_back(i + 1);
-          }
+          return false;
         }
+        changed = true;
+      }
+    }
+  }
 
-        // We have populated our vector of possible values, not to add to sudokuBoard_.
-        sudokuBoard_.push_back(SudokuGridPoint(gridX, gridY, possibleValuesVector));
-      } // End of else (!initialBoard[gridX][gridY] > 0).
-    } // End of for (gridY).
-  } // End of for (gridX).
-
-}  // End of SudokuAssist::populateSudokuBoard_.
+  return true;
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SudokuBoard::solveBoard()
+template<short BoxSize>
+template<typename Solver>
+void BasicSudokuBoard<BoxSize>::solveWith_( Solver& solver )
 {
-  // If the board is not valid we cannot solve it!
-  if ( validBoard_ )
+  if ( ! isConsistent() )
+  {
+    searchState_ = SearchState::Exhausted;
+  }
+  if ( searchState_ == SearchState::Solved || searchState_ == SearchState::Exhausted )
+  {
+    return;
+  }
+
+  // Abandon any paused search.
+  resetSearch_();
+  resetStatistics_();
+  StatisticsTimer timer(statistics_.searchNanoseconds);
+
+  short values[numberOfGridPoints];
+  short solution[numberOfGridPoints];
+
+  for ( short i(0); i < numberOfGridPoints; ++i )
   {
-    // The solver needs the current index to start at 0.
-    solveBoard_(0);
+    values[i] = sudokuBoard_[i].getValue();
   }
+
+  finishSolve_(solver.solve(values, solution), solution);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SudokuBoard::solveBoard_(unsigned int currentIndex)
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::finishSolve_( bool found,
+  const short (&solution)[numberOfGridPoints] )
 {
-  // First sort sudokuBoard_, only sort it from after the currentIndex.
-  std::sort(sudokuBoard_.begin() + currentIndex, sudokuBoard_.end());
-
-  // Check the last entry's possibleValues size.  If 0 we are done.
-  if ( currentIndex == sudokuBoard_.size() )
+  if ( found )
   {
-    // We have solved it! Go back through the recursive calls.
+    // The solution is consistent, so giving each grid point its value always succeeds.
+    for ( short i(0); i < numberOfGridPoints; ++i )
+    {
+      if ( sudokuBoard_[i].getValue() == 0 )
+      {
+        (void)assignValue_(i, solution[i]);
+      }
+    }
     boardSolvable_ = true;
+    searchState_ = SearchState::Solved;
   }
-  else if ( sudokuBoard_.at(currentIndex).getPossibleValues().size() == 0 )
+  else
   {
-    // The initial values that we skip through.
-    solveBoard_(currentIndex + 1);
+    searchState_ = SearchState::Exhausted;
   }
-  else
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+unsigned long BasicSudokuBoard<BoxSize>::searchInParallel_( unsigned long limit,
+  unsigned int numberOfThreads,
+  short (&solution)[numberOfGridPoints] )
+{
+  resetStatistics_();
+  if ( ! isConsistent() || limit == 0 )
   {
-    // This should be the grid points where there are possible values now.
+    return 0;
+  }
+
+  WorkStealingPool pool(numberOfThreads);
+  std::vector<Subproblem_> subproblems;
+
+  // Enough subproblems that the threads can balance the work between them.
+  splitSearch_(8 * pool.getNumberOfWorkers(), subproblems);
+
+  std::vector<BasicSudokuBoard> boards(pool.getNumberOfWorkers(), *this);
+  for ( auto &board : boards )
+  {
+    // Each copy only counts the work of its own thread.
+    board.statistics_ = SearchStatistics();
+  }
+  std::atomic<bool> cancelled(false);
+  std::atomic<unsigned long> solutions(0);
 
-    // Make a reference to the SudokuGridPoint we are now interested in.
-    SudokuGridPoint& gp(sudokuBoard_.at(currentIndex));
-  
-    // Make a copy of this vector of possibleValues, also record its x and y.
-    std::vector<short> possibleValuesCopy(gp.getPossibleValues());    
-  
-    for ( short val : possibleValuesCopy )
+  pool.run(subproblems.size(),
+    [&]( unsigned int worker, std::size_t task )
     {
-      for ( short otherVal : possibleValuesCopy )
+      BasicSudokuBoard& board(boards[worker]);
+
+      board.resetSearch_();
+      if ( cancelled || ! board.applySubproblem_(subproblems[task]) )
       {
-        // Remove the other possible values.  They will need restoring if solution not found.
-        if ( val != otherVal )
-        {
-          gp.removePossibleValue(gp.getX(), gp.getY(), otherVal);
-        }
+        return;
       }
-      // Now remove the value itself to add it as a guess.
-      gp.removePossibleValue(gp.getX(), gp.getY(), val);
-     
-      bool invalid(false);
-      for ( unsigned int i(currentIndex + 1); i < sudokuBoard_.size(); ++i )
+
+      while ( ! cancelled && board.nextSolution_(&cancelled) )
       {
-        if ( sudokuBoard_.at(i).removePossibleValue(gp.getX(), gp.getY(), val) == 3 )
+        const unsigned long found(++solutions);
+        if ( found == 1 )
+        {
+          for ( short i(0); i < numberOfGridPoints; ++i )
+          {
+            solution[i] = board.sudokuBoard_[i].getValue();
+          }
+        }
+        if ( found >= limit )
         {
-          // We have removed a value at another grid point, but it was it's last value.
-          // The solution down this path was not valid.
-          invalid = true;
+          cancelled = true;
         }
       }
-  
-      if ( ! invalid )
-      {
-        // Recursive call to solve the board.
-        solveBoard_(currentIndex + 1);
-      }
-  
-      // If the board was not solved return it to its previous state.
-      if ( ! boardSolvable_ )
+    });
+
+  for ( const auto &board : boards )
+  {
+    statistics_ += board.statistics_;
+  }
+
+  return std::min(solutions.load(), limit);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::splitSearch_( std::size_t target,
+  std::vector<Subproblem_>& subproblems )
+{
+  std::vector<Subproblem_> next;
+
+  subproblems.assign(1, Subproblem_());
+  subproblems[0].depth = 0;
+
+  for ( unsigned int level(0); level < maxSplitDepth_ && subproblems.size() < target; ++level )
+  {
+    next.clear();
+    for ( auto &subproblem : subproblems )
+    {
+      if ( applySubproblem_(subproblem) )
       {
-        // We did not find a solution.  Restore values.
-        for ( unsigned int i(currentIndex + 1); i < sudokuBoard_.size(); ++i )
+        const Index_ gpIndex(getMostConstrainedGridPoint_());
+
+        if ( gpIndex == noGridPoint_ )
         {
-          sudokuBoard_.at(i).restorePossibleValue(gp.getX(), gp.getY(), val);
+          // Already solved, nothing more to split.
+          next.push_back(subproblem);
         }
-        // Restore all the possible values.
-        for ( short otherVal : possibleValuesCopy )
+        else
         {
-          gp.restorePossibleValue(gp.getX(), gp.getY(), otherVal);
+          const ValueMask possibleValues(sudokuBoard_[gpIndex].getPossibleValuesMask());
+          for ( ValueMask valueIter(possibleValues); valueIter != 0; valueIter &= valueIter - 1 )
+          {
+            next.push_back(subproblem);
+            next.back().index[subproblem.depth] = gpIndex;
+            next.back().value[subproblem.depth] = static_cast<unsigned char>(
+              lowestValue(valueIter));
+            ++next.back().depth;
+          }
         }
       }
+      undoTrail_(0);
+    }
+    subproblems.swap(next);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::applySubproblem_( const Subproblem_& subproblem )
+{
+  if ( ! propagate_() )
+  {
+    return false;
+  }
+
+  for ( unsigned int i(0); i < subproblem.depth; ++i )
+  {
+    if ( ! assignValue_(subproblem.index[i], subproblem.value[i]) || ! propagate_() )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::resetSearch_()
+{
+  undoTrail_(0);
+  boardSolvable_ = false;
+  searchState_ = SearchState::NotStarted;
+  searchDepth_ = 0;
+  searchDescend_ = true;
+  searchGuesses_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::resetStatistics_()
+{
+  // The time to set up the board is kept, it only happens once.
+  const std::uint64_t populateNanoseconds(statistics_.populateNanoseconds);
+  statistics_ = SearchStatistics();
+  statistics_.populateNanoseconds = populateNanoseconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool BasicSudokuBoard<BoxSize>::nextSolution_( const std::atomic<bool>* cancelled )
+{
+  if ( searchState_ == SearchState::Solved )
+  {
+    // Backtrack from the solution as if the last guess had failed.
+    searchState_ = SearchState::Paused;
+    searchDescend_ = false;
+  }
+
+  if ( cancelled == nullptr )
+  {
+    return search_(std::numeric_limits<unsigned long>::max()) == SearchState::Solved;
+  }
+
+  // Search a few guesses at a time, checking for cancel in between.
+  SearchState state(search_(cancelCheckGuesses_));
+  while ( state == SearchState::Paused && ! *cancelled )
+  {
+    state = search_(cancelCheckGuesses_);
+  }
+
+  return state == SearchState::Solved;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::removePossibleValue_( Index_ index, short value )
+{
+  const short oldNumber(sudokuBoard_[index].getNumberOfPossibleValues());
+  sudokuBoard_[index].removePossibleValue(value);
+  moveBetweenBuckets_(index, oldNumber, oldNumber - 1);
+
+  TrailEntry_& entry(trail_[trailSize_++]);
+  entry.index = index;
+  entry.value = static_cast<unsigned char>(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::undoTrail_( std::size_t mark )
+{
+  while ( trailSize_ > mark )
+  {
+    const TrailEntry_& entry(trail_[--trailSize_]);
+    const short oldNumber(sudokuBoard_[entry.index].getNumberOfPossibleValues());
+    sudokuBoard_[entry.index].restorePossibleValue(entry.value);
+    moveBetweenBuckets_(entry.index, oldNumber, oldNumber + 1);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+typename BasicSudokuBoard<BoxSize>::Index_ BasicSudokuBoard<BoxSize>::getMostConstrainedGridPoint_()
+  const
+{
+  for ( short number(1); number <= boardSize; ++number )
+  {
+    if ( bucketHead_[number] != noGridPoint_ )
+    {
+      return bucketHead_[number];
+    }
+  }
+  return noGridPoint_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+void BasicSudokuBoard<BoxSize>::moveBetweenBuckets_( Index_ index, short oldNumber,
+  short newNumber )
+{
+  // Unlink from the old bucket.
+  if ( oldNumber > 0 )
+  {
+    if ( bucketPrev_[index] != noGridPoint_ )
+    {
+      bucketNext_[bucketPrev_[index]] = bucketNext_[index];
+    }
+    else
+    {
+      bucketHead_[oldNumber] = bucketNext_[index];
+    }
+    if ( bucketNext_[index] != noGridPoint_ )
+    {
+      bucketPrev_[bucketNext_[index]] = bucketPrev_[index];
+    }
+  }
+
+  // Link to the front of the new bucket.
+  if ( newNumber > 0 )
+  {
+    bucketPrev_[index] = noGridPoint_;
+    bucketNext_[index] = bucketHead_[newNumber];
+    if ( bucketHead_[newNumber] != noGridPoint_ )
+    {
+      bucketPrev_[bucketHead_[newNumber]] = index;
     }
-  } // End of else.
+    bucketHead_[newNumber] = index;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard() :
+  validBoard_(true),
+  boardSolvable_(false), sudokuBoard_(), trailSize_(0), valueCounts_(), unitValues_(),
+  duplicates_(0), deadGridPoints_(0), searchState_(SearchState::NotStarted), searchDepth_(0),
+  searchDescend_(true), searchGuesses_(0), statistics_()
+{
+  // Grid points without values are put in the buckets as they are populated.
+  std::fill(bucketHead_, bucketHead_ + boardSize + 1, noGridPoint_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard( const short (&initialBoard)[boardSize][boardSize] ) :
+  BasicSudokuBoard()
+{
+  populate_(&initialBoard[0][0]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard( const short (&values)[numberOfGridPoints] ) :
+  BasicSudokuBoard()
+{
+  populate_(values);
+}
 
-} // End of SolveBoard_.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard( const std::uint8_t (&values)[numberOfGridPoints] ) :
+  BasicSudokuBoard()
+{
+  populate_(values);
+}
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-SudokuBoard::SudokuBoard(const short (&initialBoard)[9][9]): validBoard_(true),
-  boardSolvable_(false), sudokuBoard_()
+template<short BoxSize>
+BasicSudokuBoard<BoxSize>::BasicSudokuBoard( const char* text, std::size_t length ) :
+  BasicSudokuBoard()
 {
-  checkBoardValues_(initialBoard);
-  // Input board seems OK, try to populate board.
-  populateSudokuBoard_(initialBoard);
+  if ( length != static_cast<std::size_t>(numberOfGridPoints) )
+  {
+    throw std::invalid_argument("Board has " + std::to_string(length) + " characters, not " +
+      std::to_string(numberOfGridPoints));
+  }
+  populate_(text);
 }
 
+// The sizes of board that are supported.
+template class BasicSudokuBoard<2>;
+template class BasicSudokuBoard<3>;
+template class BasicSudokuBoard<4>;
+template class BasicSudokuBoard<5>;
+
 } // End of namespace sudoku.
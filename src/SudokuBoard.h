@@ -2,34 +2,115 @@
 #define __sudoku_sudokuboard_h__
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief Declaration of SudokuBoard.
+/// \brief Declaration of BasicSudokuBoard.
 /// \author anon.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <type_traits>
 #include <vector>
 
+#include "DancingLinks.h"
+#include "SearchStatistics.h"
+#include "SolveLimits.h"
+#include "SudokuBitBoard.h"
 #include "SudokuGridPoint.h"
 
 namespace sudoku
 {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief SudokuBoard contains methods for manipulating a Sudoku board.
+/// \brief BasicSudokuBoard contains methods for manipulating a Sudoku board.
+/// \tparam BoxSize The size of a box, i.e. 3 for a 9x9 board.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-class SudokuBoard
+template<short BoxSize>
+class BasicSudokuBoard
 {
   public:
+    typedef BasicSudokuGridPoint<BoxSize> GridPoint; // The grid points of the board.
+    typedef BasicSudokuTables<BoxSize> Tables; // The tables describing the board.
+    static constexpr short boardSize = Tables::boardSize; // Width of the board, and values.
+    static constexpr short numberOfGridPoints = Tables::numberOfGridPoints; // Grid points.
+
+    /// \brief The state of the search for a solution.
+    enum class SearchState
+    {
+      NotStarted, // searchBoard has not been called.
+      Paused, // The search stopped after the maximum number of guesses, call searchBoard again.
+      Solved, // A solution was found.
+      Exhausted, // Every guess was tried and there is no solution.
+      Aborted // A SolveLimits stopped the search, searchBoard starts it again.
+    };
+
+    /// \brief The engines that can be used to solve the board.
+    enum class SolverEngine
+    {
+      Backtracking, // Guess values for the most constrained grid point, see searchBoard.
+      DancingLinks, // Solve as an exact cover problem, see BasicDancingLinks.
+      BitBoard // Solve with the whole board held as bits, see SudokuBitBoard.  9x9 only.
+    };
+
+    // A solution, the values of the grid points row by row.
+    typedef std::array<unsigned char, numberOfGridPoints> SolutionGrid;
+
+    // Called with each solution, returns true to carry on to the next solution or false to stop.
+    typedef std::function<bool( const SolutionGrid& )> SolutionVisitor;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \brief SudokuBoard constructor.
+    /// \brief BasicSudokuBoard constructor.  The values are checked and counted in one pass, and
+    /// nothing is allocated.
     /// \param initialBoard, the initial sudoku board.
+    /// \throws invalid_argument If any of the values are outside the range 0 to boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    BasicSudokuBoard(const short (&initialBoard)[boardSize][boardSize]);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    SudokuBoard(const short (&initialBoard)[9][9]);
+    /// \brief BasicSudokuBoard constructor.
+    /// \param values The initial values of the grid points row by row, 0 if the grid point has no
+    /// value.
+    /// \throws invalid_argument If any of the values are outside the range 0 to boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit BasicSudokuBoard(const short (&values)[numberOfGridPoints]);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief BasicSudokuBoard constructor.
+    /// \param values The initial values of the grid points row by row, 0 if the grid point has no
+    /// value.
+    /// \throws invalid_argument If any of the values are > boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit BasicSudokuBoard(const std::uint8_t (&values)[numberOfGridPoints]);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief BasicSudokuBoard constructor from text, one character for each grid point row by
+    /// row.  '.' and '0' are no value, '1' to '9' the values 1 to 9, and for bigger boards 'A' or
+    /// 'a' onwards the values from 10.
+    /// \param text The text, which need not be null terminated.
+    /// \param length The length of the text.
+    /// \throws invalid_argument If length is not numberOfGridPoints, or a character is not a
+    /// value of the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    BasicSudokuBoard(const char* text, std::size_t length);
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief BasicSudokuBoard constructor from text, as BasicSudokuBoard(const char*, size_t).
+    /// \param text The text.
+    /// \throws invalid_argument If the text is not a board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit BasicSudokuBoard(const std::string& text) :
+      BasicSudokuBoard(text.data(), text.size())
+    {
+    }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Returns if board is valid (i.e. there is not two or more of same number in
-    /// same row, column or 3*3 square).
+    /// same row, column or box).
     /// \return true if board is valid, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
     bool isValidBoard()
@@ -37,6 +118,16 @@ class SudokuBoard
       return validBoard_;
     }
     
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Returns if the board is valid and every grid point without a value has a possible
+    /// value, so as far as can be told without searching it could have a solution.
+    /// \return true if the board is consistent, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool isConsistent() const
+    {
+      return validBoard_ && deadGridPoints_ == 0;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Returns if board is solvable.
     /// \return true if board is solvable, false otherwise.
@@ -48,70 +139,446 @@ class SudokuBoard
     
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Gets the current state of the Sudoku Board.
-    /// \return The Sudoku Board.
+    /// \return The Sudoku Board, row by row, i.e. the grid point (x,y) is at index
+    /// x * boardSize + y.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    std::vector<SudokuGridPoint> getSudokuBoard() const
+    std::vector<GridPoint> getSudokuBoard() const
     {
-      return sudokuBoard_;
+      return std::vector<GridPoint>(sudokuBoard_.begin(), sudokuBoard_.end());
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the current values of the Sudoku Board.
+    /// \param values Filled with the values of the grid points row by row, 0 if the grid point has
+    /// no value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void getValues( short (&values)[numberOfGridPoints] ) const
+    {
+      for ( short i(0); i < numberOfGridPoints; ++i )
+      {
+        values[i] = sudokuBoard_[i].getValue();
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Places a value at a grid point as an initial value, replacing any value it has, and
+    /// removes it from the possible values of the peers.  Only the grid point and its peers are
+    /// updated, not the whole board.  Any search in progress, or solution found, is abandoned
+    /// first, returning the board to its initial values.
+    /// \param x The x ordinate of the grid point.
+    /// \param y The y ordinate of the grid point.
+    /// \param value The value.
+    /// \return false if the value is already in the row, column or box of the grid point, so the
+    /// board is no longer valid, true otherwise.
+    /// \throws invalid_argument if x, y or value outside valid range.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool place( short x, short y, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Erases the value of a grid point, and puts it back in the possible values of the
+    /// peers that do not have it in their row, column or box.  As place, only the grid point and
+    /// its peers are updated, and any search in progress, or solution found, is abandoned first.
+    /// \param x The x ordinate of the grid point.
+    /// \param y The y ordinate of the grid point.
+    /// \return false if the grid point has no initial value, true otherwise.
+    /// \throws invalid_argument if x and y outside valid range.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool erase( short x, short y );
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Solves the Sudoku board.
     ////////////////////////////////////////////////////////////////////////////////////////////////
     void solveBoard();
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the Sudoku board with the given engine.  If the engine is not Backtracking
+    /// any paused search is abandoned first.
+    /// \param engine The engine to use.
+    /// \throws invalid_argument If the engine is BitBoard and the board is not 9x9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void solveBoard( SolverEngine engine );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the Sudoku board, unless the search goes past a limit first.  If it does the
+    /// board is returned to how it was constructed and the search is Aborted, getSearchGuesses and
+    /// getStatistics give the work done up to then.  Any paused search is carried on.
+    /// \param limits The limits on the search.
+    /// \return The state of the search, Solved, Exhausted or Aborted.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SearchState solveBoard( const SolveLimits& limits );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the Sudoku board using several threads.  The first few levels of guesses are
+    /// split into separate subproblems, which are searched on copies of the board by a
+    /// WorkStealingPool, and the rest of the work is cancelled once one of them is solved.  Any
+    /// paused search is abandoned first.
+    /// \param numberOfThreads The number of threads, 0 for one per hardware thread.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void solveBoardInParallel( unsigned int numberOfThreads = 0 );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Searches for a solution, making at most maxGuesses guesses before pausing.  Calling
+    /// this again after it pauses resumes the search where it stopped.  Forced values (naked and
+    /// hidden singles) are given before the first guess and after every guess.  While paused the
+    /// board holds the guesses made so far, which can be inspected with getSearchDepth and
+    /// getSearchGuess.  If there is no solution the board is returned to how it was.
+    /// \param maxGuesses The maximum number of guesses to make in this call.
+    /// \return The state of the search.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SearchState searchBoard( unsigned long maxGuesses = std::numeric_limits<unsigned long>::max() );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Counts the solutions of the board, stopping once limit solutions are found.  A limit
+    /// of 2 checks whether the board has exactly one solution.  Any search in progress, or solution
+    /// found, is abandoned and the board is returned to how it was constructed.
+    /// \param limit The maximum number of solutions to count.
+    /// \return The number of solutions, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long countSolutions( unsigned long limit );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief As countSolutions, but the subproblems are searched using several threads as in
+    /// solveBoardInParallel, and the rest of the work is cancelled once limit solutions are found.
+    /// \param limit The maximum number of solutions to count.
+    /// \param numberOfThreads The number of threads, 0 for one per hardware thread.
+    /// \return The number of solutions, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long countSolutionsInParallel( unsigned long limit, unsigned int numberOfThreads = 0 );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Calls visitor with each solution of the board in turn, until there are no more or
+    /// visitor returns false.  Only one solution is held at a time, the SolutionGrid passed to
+    /// visitor is reused for the next one.  Any search in progress, or solution found, is abandoned
+    /// and the board is returned to how it was constructed.
+    /// \param visitor The visitor.
+    /// \return The number of solutions visited.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long visitSolutions( const SolutionVisitor& visitor );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the state of the search.
+    /// \return The state of the search.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SearchState getSearchState() const
+    {
+      return searchState_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of guesses currently on the search stack.
+    /// \return The depth of the search.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned int getSearchDepth() const
+    {
+      // If the search paused while backtracking the last frame on the stack has no guess.
+      return ( searchDescend_ || searchDepth_ == 0 ) ? searchDepth_ : searchDepth_ - 1;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the total number of guesses made by the search.
+    /// \return The number of guesses.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long getSearchGuesses() const
+    {
+      return searchGuesses_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the work done by the search since it was started, and the time taken to set up
+    /// the board.  The counts are cleared whenever the search is started again, for example by
+    /// countSolutions.  The parallel searches add up the work of every thread.  The DancingLinks
+    /// and BitBoard engines only keep the search time.  Every count is 0 unless the code is
+    /// compiled with SUDOKU_STATISTICS defined, see SearchStatistics.
+    /// \return The statistics.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    const SearchStatistics& getStatistics() const
+    {
+      return statistics_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets a guess on the search stack.
+    /// \param depth The depth of the guess, 0 is the first guess.
+    /// \return The guessed SudokuGridPoint, its value is the guess.
+    /// \throws out_of_range if depth is not less than getSearchDepth().
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    GridPoint getSearchGuess( unsigned int depth ) const
+    {
+      if ( depth >= getSearchDepth() )
+      {
+        throw std::out_of_range("No guess at depth " + std::to_string(depth) + ".");
+      }
+      return sudokuBoard_[searchStack_[depth].index];
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Gets the SudokuGridPoint at x and y.
     /// \return The SudokuGridPoint at x and y.
     /// \throws invalid_argument if x and y outside valid range.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    SudokuGridPoint getSudokuGridPoint(short x, short y) const
+    GridPoint getSudokuGridPoint(short x, short y) const
     {
       // Let this do the work of checking the bounds of x and y.
-      SudokuGridPoint check(x, y, 1); 
+      GridPoint check(x, y, 1); 
 
-      // If x and y are ok then we can continue.
-      for ( auto &sgp : sudokuBoard_ )
-      {
-        if ( x == sgp.getX() && y == sgp.getY() )
-        {
-          return sgp;
-        }
-      }
-
-      // If we haven't found the SudokuGridPoint that is a logic error.
-      throw std::logic_error("Couldn't find SudokuGridPoint with valid x and y passed.");
+      // If x and y are ok then we can continue, the grid points are stored row by row.
+      return sudokuBoard_[x * boardSize + y];
     }
 
+  /// Private types.
+  private:
+    // Type used to hold the index of a grid point, with room for noGridPoint_.
+    typedef typename std::conditional<( numberOfGridPoints < 0xFF ), unsigned char,
+      unsigned short>::type Index_;
+
+    static const unsigned int maxSplitDepth_ = 8; // Most levels of guesses in a subproblem.
+
+    // Struct holding the guesses that start one part of a search split across threads.
+    struct Subproblem_
+    {
+      unsigned int depth; // Number of guesses.
+      Index_ index[maxSplitDepth_]; // Index of each guessed grid point.
+      unsigned char value[maxSplitDepth_]; // Value of each guess.
+    };
+
   /// Private Methods.
   private:
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \brief Checks the values in the initial board are ok.
-    /// \param initialBoard The initial sudoku board.
-    /// \throws invalid_argument If any of the values are outside the range 0 to 9.
+    /// \brief BasicSudokuBoard constructor, for the others to delegate to.  The board is empty
+    /// until populated.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    BasicSudokuBoard();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Populates our Sudoku Board.  The values are checked and counted in their units in one
+    /// pass, then each grid point without a value is given the values not in its units.
+    /// \tparam Value short, std::uint8_t or char, see decodeValue_.
+    /// \param values The initial values row by row.
+    /// \throws invalid_argument If a value is not a value of the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename Value>
+    void populate_( const Value* values );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks an initial value.
+    /// \param value The value, 0 if the grid point has no value.
+    /// \param index The index of the grid point, for the message if it is not ok.
+    /// \return The value.
+    /// \throws invalid_argument If the value is outside the range 0 to boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static short decodeValue_( short value, short index );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks an initial value.
+    /// \param value The value, 0 if the grid point has no value.
+    /// \param index The index of the grid point, for the message if it is not ok.
+    /// \return The value.
+    /// \throws invalid_argument If the value is > boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static short decodeValue_( std::uint8_t value, short index );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Decodes an initial value written as a character.
+    /// \param character The character, see BasicSudokuBoard(const char*, size_t).
+    /// \param index The index of the grid point, for the message if it is not ok.
+    /// \return The value, 0 if the grid point has no value.
+    /// \throws invalid_argument If the character is not a value of the board.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    void checkBoardValues_( const short (&initialBoard)[9][9] ) const;
+    static short decodeValue_( char character, short index );
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \brief Populates our Sudoku Board (vector of SudokuGridPoint).
-    /// \param initialBoard The initial sudoku board.
+    /// \brief Erases an initial value, updating the counts of values in its units and the
+    /// possible values of the grid point and its peers.
+    /// \param index The index of the grid point in sudokuBoard_, which must have an initial value.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    void populateSudokuBoard_( const short (&initialBoard)[9][9] );  
+    void erase_( Index_ index );
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \brief Method that is recursively called until the Sudoku Board is solved, or not if the
-    /// Sudoku board is not solvable.
-    /// \param currentIndex All SudokuGridPoints in the SudokuBoard with index less than or equal
-    /// to this index have a value, which could be a result of guessing these values.
+    /// \brief Sets the possible values of a grid point without a value, moving it between buckets
+    /// and keeping count of the grid points left with no possible values.
+    /// \param index The index of the grid point in sudokuBoard_.
+    /// \param possibleValues The possible values.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    void solveBoard_( unsigned int currentIndex );
+    void setPossibleValues_( Index_ index, ValueMask possibleValues );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives a grid point a value, removing the value from its peers.
+    /// \param index The index of the grid point in sudokuBoard_.
+    /// \param value The value, which must be one of its possible values.
+    /// \return false if a peer would be left with no possible values, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool assignValue_( Index_ index, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives values to grid points that are forced until there are none left.  A grid point
+    /// is forced if it has one possible value (a naked single) or it is the only grid point in a
+    /// row, column or box that can have a value (a hidden single).  Removals are on the trail.
+    /// \return false if a grid point or a value in a unit is left with nowhere to go, true
+    /// otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool propagate_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the board with another solver, then gives each grid point its value.
+    /// \tparam Solver BasicDancingLinks or SudokuBitBoard.
+    /// \param solver The solver.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    template<typename Solver>
+    void solveWith_( Solver& solver );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Solves the board with SudokuBitBoard.
+    /// \throws invalid_argument If the board is not 9x9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void solveWithBitBoard_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief As searchBoard, but the statistics are not cleared when the search starts.
+    /// \param maxGuesses The maximum number of guesses to make in this call.
+    /// \return The state of the search.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SearchState search_( unsigned long maxGuesses );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Returns the board to how it was constructed and clears the search, so the board is
+    /// no longer solved.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void resetSearch_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Clears the statistics of the search, apart from the time to set up the board.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void resetStatistics_();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Carries on the search to the next solution.  If the board is solved the solution is
+    /// treated as a dead end, so the search backtracks from it.
+    /// \param cancelled If not null, the search stops soon after this is set.
+    /// \return true if another solution was found, false if there are no more or it was cancelled.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool nextSolution_( const std::atomic<bool>* cancelled = nullptr );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives each grid point without a value its value in the solution, or marks the search
+    /// as exhausted if there is no solution.
+    /// \param found Whether a solution was found.
+    /// \param solution The solution row by row, used if found is true.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void finishSolve_( bool found, const short (&solution)[numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Searches the subproblems of the board on copies of it using several threads,
+    /// stopping once limit solutions are found.  The board is returned to how it was constructed.
+    /// \param limit The maximum number of solutions to find.
+    /// \param numberOfThreads The number of threads, 0 for one per hardware thread.
+    /// \param solution Filled with the first solution found, if there is one.
+    /// \return The number of solutions found, at most limit.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned long searchInParallel_( unsigned long limit, unsigned int numberOfThreads,
+      short (&solution)[numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Splits the search into at least target subproblems, by expanding a level of guesses
+    /// at a time, up to maxSplitDepth_ levels.  Guesses that fail are left out.  The board must
+    /// be as it was constructed, and is left that way.
+    /// \param target The number of subproblems wanted.
+    /// \param subproblems Filled with the subproblems.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void splitSearch_( std::size_t target, std::vector<Subproblem_>& subproblems );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gives the forced values, then each guess of a subproblem followed by the values it
+    /// forces.  Removals are on the trail.
+    /// \param subproblem The subproblem.
+    /// \return false if the subproblem has no solution, true otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool applySubproblem_( const Subproblem_& subproblem );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the unsolved grid point with the fewest possible values.
+    /// \return The index of the grid point in sudokuBoard_, or noGridPoint_ if all are solved.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    Index_ getMostConstrainedGridPoint_() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Moves a grid point between buckets after its number of possible values changed.
+    /// Grid points with no possible values (initial values and guesses) are in no bucket.
+    /// \param index The index of the grid point in sudokuBoard_.
+    /// \param oldNumber The number of possible values before the change.
+    /// \param newNumber The number of possible values after the change.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void moveBetweenBuckets_( Index_ index, short oldNumber, short newNumber );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Removes a possible value from a grid point, recording the removal on the trail so it
+    /// can be undone.
+    /// \param index The index of the grid point in sudokuBoard_.
+    /// \param value The value to remove, which must be a possible value of the grid point.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void removePossibleValue_( Index_ index, short value );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Undoes removals on the trail, most recent first, until the trail is back to mark.
+    /// \param mark The size of the trail to return to.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void undoTrail_( std::size_t mark );
 
   /// Private variables.
   private:
+    // Struct that records a guess on the search stack.
+    struct SearchFrame_
+    {
+      Index_ index; // Index of the guessed grid point.
+      ValueMask untried; // Possible values not yet guessed.
+      std::size_t mark; // Size of the trail before the guess.
+    };
+
+    // Struct that records a possible value removed during solving.
+    struct TrailEntry_
+    {
+      Index_ index; // Index of the grid point the value was removed from.
+      unsigned char value; // The value removed.
+    };
+
+    static const Index_ noGridPoint_ = static_cast<Index_>(~0); // Marks the end of a bucket.
+    static const unsigned long cancelCheckGuesses_ = 256; // Guesses between checks for cancel.
+
     bool validBoard_; // Indicates if board is valid.
     bool boardSolvable_; // Indicates if the board is solved.
-    std::vector<SudokuGridPoint> sudokuBoard_; // sudoku board, will be returned.
+    std::array<GridPoint, numberOfGridPoints> sudokuBoard_; // sudoku board, stored row by row.
+    // Possible values removed while solving, in removal order.  Each value can only be removed from
+    // each grid point once at a time, so it cannot hold more than every possible value.
+    TrailEntry_ trail_[numberOfGridPoints * boardSize];
+    std::size_t trailSize_; // The number of removals on trail_.
+
+    // The initial values in each unit, so that placing or erasing a value only updates its units.
+    unsigned char valueCounts_[Tables::numberOfUnits][boardSize]; // Times each value is in a unit.
+    ValueMask unitValues_[Tables::numberOfUnits]; // The values in each unit.
+    short duplicates_; // Values in a unit more than once, counted once for each unit and value.
+    short deadGridPoints_; // Grid points without a value that have no possible values.
+
+    // Unsolved grid points are kept in doubly linked lists (buckets) by their number of possible
+    // values, so the most constrained grid point can be found without sorting.
+    Index_ bucketHead_[boardSize + 1]; // First grid point in each bucket, noGridPoint_ if empty.
+    Index_ bucketNext_[numberOfGridPoints]; // Next grid point in the same bucket.
+    Index_ bucketPrev_[numberOfGridPoints]; // Previous grid point in the same bucket.
+
+    // The search is a loop over an explicit stack, at most one guess per grid point.
+    SearchState searchState_; // State of the search.
+    SearchFrame_ searchStack_[numberOfGridPoints]; // The guesses, searchStack_[0] is the first.
+    unsigned int searchDepth_; // Number of guesses on searchStack_.
+    bool searchDescend_; // Whether the next step picks a new grid point to guess.
+    unsigned long searchGuesses_; // Total number of guesses made.
+    SearchStatistics statistics_; // The work done by the search, if it is kept.
 };
+
+template<short BoxSize>
+constexpr short BasicSudokuBoard<BoxSize>::boardSize;
+template<short BoxSize>
+constexpr short BasicSudokuBoard<BoxSize>::numberOfGridPoints;
+
+// The standard 9x9 board.
+typedef BasicSudokuBoard<3> SudokuBoard;
  
 } // End of namespace sudoku.
 
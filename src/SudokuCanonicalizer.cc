@@ -0,0 +1,530 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of SudokuTransform and SudokuCanonicalizer.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "SudokuCanonicalizer.h"
+
+namespace sudoku
+{
+
+namespace
+{
+
+const short boxSize(3); // Rows in a band, and columns in a stack.
+const short boardSize(SudokuTables::boardSize); // Rows and columns in a board.
+const short newValue(boardSize + 1); // Sorts a value with no label after every label.
+
+} // End of anonymous namespace.
+
+const short SudokuCanonicalizer::numberOfColumnOrders_;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuTransform SudokuTransform::identity()
+{
+  SudokuTransform transform;
+
+  transform.transpose = false;
+  for ( short i(0); i < boardSize; ++i )
+  {
+    transform.rows[i] = i;
+    transform.columns[i] = i;
+  }
+  for ( short value(0); value <= boardSize; ++value )
+  {
+    transform.values[value] = value;
+  }
+
+  return transform;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTransform::apply( const short (&board)[SudokuTables::numberOfGridPoints],
+  short (&result)[SudokuTables::numberOfGridPoints] ) const
+{
+  // The steps between rows and between columns of the board, swapped if it is transposed.
+  const short rowStep(transpose ? 1 : boardSize);
+  const short columnStep(transpose ? boardSize : 1);
+
+  for ( short row(0); row < boardSize; ++row )
+  {
+    for ( short column(0); column < boardSize; ++column )
+    {
+      result[row * boardSize + column] =
+        values[board[rows[row] * rowStep + columns[column] * columnStep]];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuTransform SudokuTransform::inverse() const
+{
+  SudokuTransform result;
+  short inverseRows[boardSize];
+  short inverseColumns[boardSize];
+
+  for ( short i(0); i < boardSize; ++i )
+  {
+    inverseRows[rows[i]] = i;
+    inverseColumns[columns[i]] = i;
+  }
+  for ( short value(0); value <= boardSize; ++value )
+  {
+    result.values[values[value]] = value;
+  }
+
+  // Undoing a swap after the reordering is the same as swapping first and reordering the rows by
+  // the inverse column order and the columns by the inverse row order.
+  result.transpose = transpose;
+  std::copy(inverseRows, inverseRows + boardSize, transpose ? result.columns : result.rows);
+  std::copy(inverseColumns, inverseColumns + boardSize, transpose ? result.rows : result.columns);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuCanonicalizer::SudokuCanonicalizer()
+  : columnOrders_(), boards_(), current_(SudokuTransform::identity()),
+    rowUsed_(),
+    best_(), bestRows_(0), bestTransform_(SudokuTransform::identity()),
+    states_(), nextStates_()
+{
+  // Every order of the stacks, with every order of the columns in each stack.
+  short stacks[boxSize] = { 0, 1, 2 };
+  short numberOfOrders(0);
+  do
+  {
+    for ( short orders(0); orders < 6 * 6 * 6; ++orders )
+    {
+      short rest(orders);
+      for ( short position(0); position < boxSize; ++position, rest /= 6 )
+      {
+        short columns[boxSize] = { 0, 1, 2 };
+        for ( short i(0); i < rest % 6; ++i )
+        {
+          std::next_permutation(columns, columns + boxSize);
+        }
+        for ( short i(0); i < boxSize; ++i )
+        {
+          columnOrders_[numberOfOrders][position * boxSize + i] =
+            stacks[position] * boxSize + columns[i];
+        }
+      }
+      ++numberOfOrders;
+    }
+  }
+  while ( std::next_permutation(stacks, stacks + boxSize) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuTransform SudokuCanonicalizer::canonicalize(
+  const short (&board)[SudokuTables::numberOfGridPoints],
+  short (&canonical)[SudokuTables::numberOfGridPoints] )
+{
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    if ( board[i] < 0 || board[i] > boardSize )
+    {
+      throw std::invalid_argument("Grid point " + std::to_string(i) + " has value " +
+        std::to_string(board[i]));
+    }
+    boards_[0][i] = board[i];
+    boards_[1][( i % boardSize ) * boardSize + i / boardSize] = board[i];
+  }
+
+  if ( ! hasRepeatedValues_() )
+  {
+    return refineRows_(canonical);
+  }
+
+  bestRows_ = 0;
+  const short noLabels[boardSize + 1] = { 0 };
+
+  for ( short transpose(0); transpose < 2; ++transpose )
+  {
+    current_.transpose = transpose == 1;
+    for ( short order(0); order < numberOfColumnOrders_; ++order )
+    {
+      std::copy(columnOrders_[order], columnOrders_[order] + boardSize, current_.columns);
+      chooseRows_(0, noLabels, 0);
+    }
+  }
+
+  std::copy(best_, best_ + SudokuTables::numberOfGridPoints, canonical);
+  return bestTransform_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuBoard SudokuCanonicalizer::canonicalize( const SudokuBoard& board,
+  SudokuTransform& transform )
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short canonical[SudokuTables::numberOfGridPoints];
+
+  board.getValues(values);
+  transform = canonicalize(values, canonical);
+  return SudokuBoard(canonical);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuCanonicalizer::hasRepeatedValues_() const
+{
+  // The rows of the transposed board are the columns of the board.
+  for ( short transpose(0); transpose < 2; ++transpose )
+  {
+    for ( short row(0); row < boardSize; ++row )
+    {
+      bool seen[boardSize + 1] = { false };
+      for ( short column(0); column < boardSize; ++column )
+      {
+        const short value(boards_[transpose][row * boardSize + column]);
+        if ( value != 0 && seen[value] )
+        {
+          return true;
+        }
+        seen[value] = true;
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuTransform SudokuCanonicalizer::refineRows_(
+  short (&canonical)[SudokuTables::numberOfGridPoints] )
+{
+  // Before any row is chosen every stack, and every column in it, can be in any order.
+  State_ start;
+  start.transform = SudokuTransform::identity();
+  std::fill(start.labels, start.labels + boardSize + 1, 0);
+  start.numberOfLabels = 0;
+  start.usedRows = 0;
+  start.freeStacks = boxSize;
+  std::fill(start.freeColumns, start.freeColumns + boxSize, boxSize);
+
+  states_.clear();
+  states_.push_back(start);
+  start.transform.transpose = true;
+  states_.push_back(start);
+
+  for ( short position(0); position < boardSize; ++position )
+  {
+    short* bestValues(canonical + position * boardSize);
+    bool found(false);
+    nextStates_.clear();
+
+    for ( State_& state : states_ )
+    {
+      const short* board(boards_[state.transform.transpose]);
+      bool emptyRowTried[boxSize] = { false };
+
+      for ( short row(0); row < boardSize; ++row )
+      {
+        // The first row of a band can be any row of a band not yet used, the others must be from
+        // the same band as the row before.
+        if ( ( state.usedRows & ( 1 << row ) ) != 0 ||
+             ( position % boxSize != 0 &&
+               row / boxSize != state.transform.rows[position - 1] / boxSize ) )
+        {
+          continue;
+        }
+
+        // Rows with no values in the same band give the same boards, so only one is tried.
+        const short* boardRow(board + row * boardSize);
+        if ( std::count(boardRow, boardRow + boardSize, 0) == boardSize )
+        {
+          if ( emptyRowTried[row / boxSize] )
+          {
+            continue;
+          }
+          emptyRowTried[row / boxSize] = true;
+        }
+
+        // Once every column has its position the row can be compared before anything is copied.
+        if ( found && state.freeStacks == 0 &&
+             std::count(state.freeColumns, state.freeColumns + boxSize, 0) == boxSize &&
+             isLarger_(state, boardRow, bestValues) )
+        {
+          continue;
+        }
+
+        State_ next;
+        short values[boardSize];
+        Segment_ segments[4];
+        const short numberOfSegments(arrangeRow_(state, position, row, next, values, segments));
+
+        if ( found )
+        {
+          const auto mismatch(std::mismatch(values, values + boardSize, bestValues));
+          if ( mismatch.first != values + boardSize )
+          {
+            if ( *mismatch.first > *mismatch.second )
+            {
+              continue;
+            }
+            nextStates_.clear();
+          }
+        }
+        std::copy(values, values + boardSize, bestValues);
+        found = true;
+        addStates_(next, position, segments, numberOfSegments);
+      }
+    }
+
+    states_.swap(nextStates_);
+  }
+
+  // Every state left makes the smallest board, the values not on it take the labels left, in
+  // order.
+  State_& best(states_.front());
+  for ( short value(1); value <= boardSize; ++value )
+  {
+    if ( best.labels[value] == 0 )
+    {
+      best.labels[value] = ++best.numberOfLabels;
+    }
+  }
+  std::copy(best.labels, best.labels + boardSize + 1, best.transform.values);
+
+  return best.transform;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool SudokuCanonicalizer::isLarger_( const State_& state, const short* boardRow,
+  const short* values )
+{
+  short label(state.numberOfLabels);
+  for ( short column(0); column < boardSize; ++column )
+  {
+    const short value(boardRow[state.transform.columns[column]]);
+    const short rowValue(value == 0 || state.labels[value] != 0 ? state.labels[value] : ++label);
+    if ( rowValue != values[column] )
+    {
+      return rowValue > values[column];
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuCanonicalizer::arrangeRow_( const State_& state, short position, short row,
+  State_& next, short (&values)[SudokuTables::boardSize], Segment_ (&segments)[4] ) const
+{
+  const short* boardRow(boards_[state.transform.transpose] + row * boardSize);
+  short keys[boardSize]; // The key of each column, what its value sorts by.
+  for ( short column(0); column < boardSize; ++column )
+  {
+    const short value(boardRow[column]);
+    keys[column] = value == 0 ? 0 : state.labels[value] != 0 ? state.labels[value] : newValue;
+  }
+  const auto byKey([&keys]( short first, short second ) { return keys[first] < keys[second]; });
+  const auto stackByKeys([&keys]( const short* first, const short* second )
+  {
+    return std::lexicographical_compare(first, first + boxSize, second, second + boxSize,
+      [&keys]( short a, short b ) { return keys[a] < keys[b]; });
+  });
+
+  next = state;
+  next.transform.rows[position] = row;
+  next.usedRows = static_cast<short>(state.usedRows | ( 1 << row ));
+  short* columns(next.transform.columns);
+
+  // The stacks with no values so far are sorted by their columns sorted, stacks with no value in
+  // this row first and still free.
+  short stacks[boxSize][boxSize];
+  const short* sortedStacks[boxSize];
+  for ( short stack(0); stack < state.freeStacks; ++stack )
+  {
+    std::copy(columns + stack * boxSize, columns + ( stack + 1 ) * boxSize, stacks[stack]);
+    std::sort(stacks[stack], stacks[stack] + boxSize, byKey);
+    sortedStacks[stack] = stacks[stack];
+  }
+  std::stable_sort(sortedStacks, sortedStacks + state.freeStacks, stackByKeys);
+  next.freeStacks = 0;
+  for ( short stack(0); stack < state.freeStacks; ++stack )
+  {
+    std::copy(sortedStacks[stack], sortedStacks[stack] + boxSize, columns + stack * boxSize);
+    if ( keys[sortedStacks[stack][boxSize - 1]] == 0 )
+    {
+      ++next.freeStacks;
+    }
+  }
+
+  // Stacks with the same keys differ only in their new values, so every order of them is tried.
+  short numberOfSegments(0);
+  for ( short stack(next.freeStacks); stack < state.freeStacks; )
+  {
+    short end(stack + 1);
+    while ( end < state.freeStacks &&
+            ! stackByKeys(sortedStacks[stack], sortedStacks[end]) )
+    {
+      ++end;
+    }
+    if ( end - stack > 1 )
+    {
+      segments[numberOfSegments++] = { true, stack, static_cast<short>(end - stack) };
+    }
+    stack = end;
+  }
+
+  // The free columns of each stack are sorted, those with no value in this row are still free
+  // and every order of the new values is tried.
+  for ( short stack(next.freeStacks); stack < boxSize; ++stack )
+  {
+    short* first(columns + stack * boxSize);
+    const short free(stack < state.freeStacks ? boxSize : state.freeColumns[stack]);
+    std::sort(first, first + free, byKey);
+    next.freeColumns[stack] =
+      static_cast<short>(std::count_if(first, first + free, [&keys]( short column )
+      {
+        return keys[column] == 0;
+      }));
+    const short numberOfNewValues(static_cast<short>(std::count_if(first, first + free,
+      [&keys]( short column ) { return keys[column] == newValue; })));
+    if ( numberOfNewValues > 1 )
+    {
+      segments[numberOfSegments++] = { false,
+        static_cast<short>(stack * boxSize + free - numberOfNewValues), numberOfNewValues };
+    }
+  }
+
+  short label(state.numberOfLabels);
+  for ( short column(0); column < boardSize; ++column )
+  {
+    const short key(keys[columns[column]]);
+    values[column] = key == newValue ? ++label : key;
+  }
+
+  return numberOfSegments;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizer::addStates_( State_& state, short position, const Segment_* segments,
+  short numberOfSegments )
+{
+  short* columns(state.transform.columns);
+
+  if ( numberOfSegments == 0 )
+  {
+    nextStates_.push_back(state);
+    State_& added(nextStates_.back());
+    const short* boardRow(boards_[state.transform.transpose] +
+      state.transform.rows[position] * boardSize);
+    for ( short column(0); column < boardSize; ++column )
+    {
+      const short value(boardRow[columns[column]]);
+      if ( value != 0 && added.labels[value] == 0 )
+      {
+        added.labels[value] = ++added.numberOfLabels;
+      }
+    }
+  }
+  else if ( segments->stacks )
+  {
+    short stacks[boxSize][boxSize];
+    short order[boxSize] = { 0, 1, 2 };
+    short* first(columns + segments->first * boxSize);
+    for ( short stack(0); stack < segments->size; ++stack )
+    {
+      std::copy(first + stack * boxSize, first + ( stack + 1 ) * boxSize, stacks[stack]);
+    }
+    do
+    {
+      for ( short stack(0); stack < segments->size; ++stack )
+      {
+        std::copy(stacks[order[stack]], stacks[order[stack]] + boxSize, first + stack * boxSize);
+      }
+      addStates_(state, position, segments + 1, numberOfSegments - 1);
+    }
+    while ( std::next_permutation(order, order + segments->size) );
+  }
+  else
+  {
+    short* first(columns + segments->first);
+    std::sort(first, first + segments->size);
+    do
+    {
+      addStates_(state, position, segments + 1, numberOfSegments - 1);
+    }
+    while ( std::next_permutation(first, first + segments->size) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizer::chooseRows_( short position,
+  const short (&labels)[SudokuTables::boardSize + 1], short numberOfLabels )
+{
+  for ( short row(0); row < boardSize; ++row )
+  {
+    // The first row of a band can be any row of a band not yet used, the others must be from the
+    // same band as the row before.
+    if ( rowUsed_[row] ||
+         ( position % boxSize != 0 && row / boxSize != current_.rows[position - 1] / boxSize ) )
+    {
+      continue;
+    }
+
+    short rowLabels[boardSize + 1];
+    std::copy(labels, labels + boardSize + 1, rowLabels);
+    short rowNumberOfLabels(numberOfLabels);
+
+    const short* boardRow(boards_[current_.transpose] + row * boardSize);
+    short values[boardSize];
+    for ( short column(0); column < boardSize; ++column )
+    {
+      const short value(boardRow[current_.columns[column]]);
+      if ( value != 0 && rowLabels[value] == 0 )
+      {
+        rowLabels[value] = ++rowNumberOfLabels;
+      }
+      values[column] = rowLabels[value];
+    }
+
+    // Compare with the same row of the best board, any row beats one that is not set.
+    short* bestValues(best_ + position * boardSize);
+    bool better(position >= bestRows_);
+    if ( ! better )
+    {
+      const auto mismatch(std::mismatch(values, values + boardSize, bestValues));
+      if ( mismatch.first != values + boardSize && *mismatch.first > *mismatch.second )
+      {
+        continue;
+      }
+      better = mismatch.first != values + boardSize;
+    }
+    if ( better )
+    {
+      std::copy(values, values + boardSize, bestValues);
+      bestRows_ = position + 1;
+    }
+
+    current_.rows[position] = row;
+    if ( position + 1 < boardSize )
+    {
+      rowUsed_[row] = true;
+      chooseRows_(position + 1, rowLabels, rowNumberOfLabels);
+      rowUsed_[row] = false;
+    }
+    else if ( better )
+    {
+      // The values not on the board take the labels left, in order.
+      for ( short value(1); value <= boardSize; ++value )
+      {
+        if ( rowLabels[value] == 0 )
+        {
+          rowLabels[value] = ++rowNumberOfLabels;
+        }
+      }
+      std::copy(rowLabels, rowLabels + boardSize + 1, current_.values);
+      bestTransform_ = current_;
+    }
+  }
+}
+
+} // End of namespace sudoku.
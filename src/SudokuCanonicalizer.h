@@ -0,0 +1,189 @@
+#ifndef __sudoku_sudokucanonicalizer_h__
+#define __sudoku_sudokucanonicalizer_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SudokuTransform and SudokuCanonicalizer.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <vector>
+
+#include "SudokuBoard.h"
+#include "SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuTransform is one of the changes to a 9x9 board that keep it valid: optionally
+/// swapping the rows and columns, then reordering the rows (bands of three rows, and the rows in
+/// each band), reordering the columns in the same way, and relabelling the values.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+struct SudokuTransform
+{
+  bool transpose; // Whether the rows and columns are swapped first.
+  short rows[SudokuTables::boardSize]; // Row i of the result is row rows[i] of the board.
+  short columns[SudokuTables::boardSize]; // Column i of the result is column columns[i].
+  short values[SudokuTables::boardSize + 1]; // Value v becomes values[v], values[0] is 0.
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Makes the transform that changes nothing.
+  /// \return The transform.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  static SudokuTransform identity();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Applies the transform to a board.
+  /// \param board The values row by row, 0 if the grid point has no value.
+  /// \param result Filled with the transformed values, must not be board.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  void apply( const short (&board)[SudokuTables::numberOfGridPoints],
+    short (&result)[SudokuTables::numberOfGridPoints] ) const;
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// \brief Makes the transform that undoes this one, for example to take the solution of a
+  /// canonical puzzle back to the puzzle it came from.
+  /// \return The inverse.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  SudokuTransform inverse() const;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuCanonicalizer finds the canonical form of 9x9 boards: of all the boards a
+/// SudokuTransform can make from a board, the one whose values row by row are smallest, with 0 for
+/// no value.  Two boards have the same canonical form exactly when one can be transformed into the
+/// other, so it can be used as a key to find repeats.
+///
+/// The rows are chosen one position at a time, keeping only the partial transforms whose rows so
+/// far are the smallest.  For each candidate row the columns are put in the order that makes it
+/// smallest: no value first, then the values already labelled, then new values, which take the
+/// next labels in the order they are seen.  Columns and stacks with no values in the rows chosen
+/// so far can still be in any order, so they are only ordered once a row tells them apart, and
+/// only the orders of new values are tried one by one.  This relies on no value repeating in a
+/// row or column; for a board where one does, every swap and column order is tried instead (2 x
+/// 1296).  The search state is kept in the object, so a canonicalizer should be reused but not
+/// shared between threads.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuCanonicalizer
+{
+  public:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief SudokuCanonicalizer constructor.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuCanonicalizer();
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the canonical form of a board.
+    /// \param board The values row by row, 0 if the grid point has no value.
+    /// \param canonical Filled with the canonical form.
+    /// \return The transform that makes canonical from board.
+    /// \throws invalid_argument If a value is outside the range 0 to 9.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuTransform canonicalize( const short (&board)[SudokuTables::numberOfGridPoints],
+      short (&canonical)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the canonical form of the current values of a board.
+    /// \param board The board.
+    /// \param transform Set to the transform that makes the canonical form from board.
+    /// \return A board holding the canonical form.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuBoard canonicalize( const SudokuBoard& board, SudokuTransform& transform );
+
+  /// Private Methods.
+  private:
+    // A transform with the rows chosen up to a position, and the columns it can still have.
+    struct State_
+    {
+      SudokuTransform transform; // The rows chosen so far, and the columns in an order they allow.
+      short labels[SudokuTables::boardSize + 1]; // The label of each value, 0 if none yet.
+      short numberOfLabels; // The number of labels given.
+      short usedRows; // A bit for each row chosen so far.
+      short freeStacks; // The stacks at the positions before this have had no values so far.
+      short freeColumns[3]; // The first columns of the stack at each position with no values.
+    };
+
+    // Positions whose columns, or whose stacks, give the same row in any order.
+    struct Segment_
+    {
+      bool stacks; // Whether first and size count stacks rather than columns.
+      short first; // The first position.
+      short size; // The number of positions.
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a value repeats in a row or column of the board.
+    /// \return true if one does, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool hasRepeatedValues_() const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Finds the smallest board by choosing the rows one position at a time.
+    /// \param canonical Filled with the smallest board.
+    /// \return The transform that makes it.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    SudokuTransform refineRows_( short (&canonical)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks whether a row is larger than the values given, for a state whose columns all
+    /// have their positions.
+    /// \param state The state.
+    /// \param boardRow The values of the row, in the order of the board.
+    /// \param values The values to compare with.
+    /// \return true if the row is larger, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static bool isLarger_( const State_& state, const short* boardRow, const short* values );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Puts the columns of a state in the order that makes a row smallest at a position.
+    /// \param state The state.
+    /// \param position The position of the row.
+    /// \param row The row.
+    /// \param next Set to the state with the row and one of the smallest column orders.
+    /// \param values Filled with the values of the row in that order.
+    /// \param segments Filled with the positions whose order does not change values.
+    /// \return The number of segments.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short arrangeRow_( const State_& state, short position, short row, State_& next,
+      short (&values)[SudokuTables::boardSize], Segment_ (&segments)[4] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Adds a state to nextStates_ for every order of the segments, labelling the new
+    /// values of the row at position in each.
+    /// \param state The state, its segments are left in their first order.
+    /// \param position The position of the row.
+    /// \param segments The segments.
+    /// \param numberOfSegments The number of segments.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void addStates_( State_& state, short position, const Segment_* segments,
+      short numberOfSegments );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Chooses the row at position, and the rows after it, for the current column order.
+    /// \param position The position of the row in the result.
+    /// \param labels The label given to each value by the rows before position, 0 if none yet.
+    /// \param numberOfLabels The number of labels given.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void chooseRows_( short position, const short (&labels)[SudokuTables::boardSize + 1],
+      short numberOfLabels );
+
+  /// Private variables.
+  private:
+    static const short numberOfColumnOrders_ = 1296; // The column orders, 3! x 3!^3.
+
+    // The column orders.
+    short columnOrders_[numberOfColumnOrders_][SudokuTables::boardSize];
+
+    short boards_[2][SudokuTables::numberOfGridPoints]; // The board, and the board transposed.
+    SudokuTransform current_; // The transform being built.
+    bool rowUsed_[SudokuTables::boardSize]; // Whether each row has a position in current_.
+    short best_[SudokuTables::numberOfGridPoints]; // The smallest board found.
+    short bestRows_; // The number of rows of best_ still to beat, those after are not set.
+    SudokuTransform bestTransform_; // The transform that makes best_.
+    std::vector<State_> states_; // The states whose rows so far are the smallest.
+    std::vector<State_> nextStates_; // The states with one more row.
+};
+
+} // End of namespace sudoku.
+
+#endif
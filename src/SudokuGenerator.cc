@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of SudokuGenerator.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+
+#include "SudokuGenerator.h"
+
+namespace sudoku
+{
+
+const unsigned int SudokuGenerator::maxFullBoards_;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuGenerator::SudokuGenerator( short numberOfClues, Symmetry symmetry,
+  unsigned int numberOfThreads )
+  : numberOfClues_(numberOfClues), symmetry_(symmetry), pool_(numberOfThreads), solvers_()
+{
+  for ( unsigned int worker(0); worker < pool_.getNumberOfWorkers(); ++worker )
+  {
+    solvers_.emplace_back(new SudokuBitBoard());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuGenerator::generate( std::uint64_t seed,
+  short (&puzzle)[SudokuTables::numberOfGridPoints] )
+{
+  return generatePuzzle_(*solvers_[0], seed, 0, puzzle);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::size_t SudokuGenerator::generate( std::uint64_t seed, std::size_t numberOfPuzzles,
+  std::vector<std::string>& puzzles, std::uint64_t firstPuzzle, std::vector<short>* clues )
+{
+  std::atomic<std::size_t> missed(0);
+
+  puzzles.resize(numberOfPuzzles);
+  if ( clues != nullptr )
+  {
+    clues->resize(numberOfPuzzles);
+  }
+
+  pool_.run(numberOfPuzzles,
+    [this, seed, firstPuzzle, &puzzles, clues, &missed]( unsigned int worker, std::size_t task )
+    {
+      short puzzle[SudokuTables::numberOfGridPoints];
+      const short puzzleClues(generatePuzzle_(*solvers_[worker], seed, firstPuzzle + task, puzzle));
+      if ( numberOfClues_ > 0 && puzzleClues > numberOfClues_ )
+      {
+        ++missed;
+      }
+      if ( clues != nullptr )
+      {
+        (*clues)[task] = puzzleClues;
+      }
+
+      std::string& result(puzzles[task]);
+      result.assign(SudokuTables::numberOfGridPoints, '.');
+      for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+      {
+        if ( puzzle[i] != 0 )
+        {
+          result[i] = static_cast<char>('0' + puzzle[i]);
+        }
+      }
+    });
+
+  return missed;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuGenerator::generatePuzzle_( SudokuBitBoard& solver, std::uint64_t seed,
+  std::uint64_t number, short (&puzzle)[SudokuTables::numberOfGridPoints] ) const
+{
+  // Mix the seed and the number so neighbouring puzzles do not share random numbers.
+  std::seed_seq seeds{ static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32),
+    static_cast<std::uint32_t>(number), static_cast<std::uint32_t>(number >> 32) };
+  std::mt19937_64 random(seeds);
+
+  short board[SudokuTables::numberOfGridPoints];
+  short fewestClues(SudokuTables::numberOfGridPoints + 1);
+
+  // A minimal puzzle can be made from any full board, so only try one.
+  const unsigned int fullBoards(numberOfClues_ > 0 ? maxFullBoards_ : 1);
+
+  for ( unsigned int attempt(0); attempt < fullBoards && fewestClues > numberOfClues_; ++attempt )
+  {
+    makeFullBoard_(solver, random, board);
+    const short clues(removeValues_(solver, random, board));
+    if ( clues < fewestClues )
+    {
+      fewestClues = clues;
+      std::copy(board, board + SudokuTables::numberOfGridPoints, puzzle);
+    }
+  }
+
+  return fewestClues;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGenerator::makeFullBoard_( SudokuBitBoard& solver, std::mt19937_64& random,
+  short (&board)[SudokuTables::numberOfGridPoints] )
+{
+  short values[SudokuTables::numberOfGridPoints] = { 0 };
+  short shuffled[SudokuTables::boardSize];
+
+  for ( short box(0); box < SudokuTables::boxSize; ++box )
+  {
+    std::iota(shuffled, shuffled + SudokuTables::boardSize, 1);
+    std::shuffle(shuffled, shuffled + SudokuTables::boardSize, random);
+
+    const SudokuTables::Index* gridPoints(
+      SudokuTables::getUnit(2 * SudokuTables::boardSize + box * ( SudokuTables::boxSize + 1 )));
+    for ( short i(0); i < SudokuTables::boardSize; ++i )
+    {
+      values[gridPoints[i]] = shuffled[i];
+    }
+  }
+
+  // Any values in the boxes on the diagonal can be completed.
+  (void)solver.solve(values, board);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuGenerator::removeValues_( SudokuBitBoard& solver, std::mt19937_64& random,
+  short (&board)[SudokuTables::numberOfGridPoints] ) const
+{
+  short order[SudokuTables::numberOfGridPoints];
+  std::iota(order, order + SudokuTables::numberOfGridPoints, 0);
+  std::shuffle(order, order + SudokuTables::numberOfGridPoints, random);
+
+  short clues(SudokuTables::numberOfGridPoints);
+
+  for ( short i(0); i < SudokuTables::numberOfGridPoints && clues > numberOfClues_; ++i )
+  {
+    // Values are taken out in symmetric pairs, so the other one is gone if this one is.
+    const short gridPoint(order[i]);
+    const short other(getSymmetricGridPoint_(gridPoint));
+    const short removed(other == gridPoint ? 1 : 2);
+    if ( board[gridPoint] == 0 || clues - removed < numberOfClues_ )
+    {
+      continue;
+    }
+
+    const short value(board[gridPoint]);
+    const short otherValue(board[other]);
+    board[gridPoint] = 0;
+    board[other] = 0;
+
+    // Taking out more values only adds solutions, so a value that has to stay is never tried
+    // again.
+    if ( solver.countSolutions(board, 2) == 1 )
+    {
+      clues -= removed;
+    }
+    else
+    {
+      board[gridPoint] = value;
+      board[other] = otherValue;
+    }
+  }
+
+  return clues;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short SudokuGenerator::getSymmetricGridPoint_( short gridPoint ) const
+{
+  const short last(SudokuTables::boardSize - 1);
+  const short x(gridPoint / SudokuTables::boardSize);
+  const short y(gridPoint % SudokuTables::boardSize);
+
+  switch ( symmetry_ )
+  {
+    case Symmetry::Rotational:
+      return ( last - x ) * SudokuTables::boardSize + last - y;
+    case Symmetry::Mirror:
+      return x * SudokuTables::boardSize + last - y;
+    case Symmetry::Diagonal:
+      return y * SudokuTables::boardSize + x;
+    default:
+      return gridPoint;
+  }
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,128 @@
+#ifndef __sudoku_sudokugenerator_h__
+#define __sudoku_sudokugenerator_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of SudokuGenerator.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SudokuBitBoard.h"
+#include "WorkStealingPool.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuGenerator makes 9x9 puzzles with exactly one solution.  A random full board is
+/// made, then values are taken out in a random order, and put back if the board is left with more
+/// than one solution, until the board has the number of values wanted or none can be taken out.
+/// The solutions are counted, stopping at 2, by a SudokuBitBoard that each worker reuses for every
+/// check.  The puzzles made depend only on the seed, not on the number of threads.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuGenerator
+{
+  public:
+    /// \brief The symmetry of the grid points given values in the puzzles made.
+    enum class Symmetry
+    {
+      None, // No symmetry.
+      Rotational, // The same after turning the board half way round.
+      Mirror, // The same after swapping the left and right of the board.
+      Diagonal // The same after swapping the rows and the columns.
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief SudokuGenerator constructor.
+    /// \param numberOfClues The number of values wanted in each puzzle, 0 for puzzles that no value
+    /// can be taken out of.
+    /// \param symmetry The symmetry of the puzzles.
+    /// \param numberOfThreads The number of threads, 0 for one per hardware thread.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit SudokuGenerator( short numberOfClues = 0, Symmetry symmetry = Symmetry::None,
+      unsigned int numberOfThreads = 0 );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes a puzzle.  If no puzzle with numberOfClues values is found after a few full
+    /// boards have been tried, the one with the fewest values is given.
+    /// \param seed The seed, the same seed always gives the same puzzle.
+    /// \param puzzle Filled with the values row by row, 0 if the grid point has no value.
+    /// \return The number of values in the puzzle.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short generate( std::uint64_t seed, short (&puzzle)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes many puzzles using several threads.  Each seed gives a sequence of puzzles,
+    /// the first of which is the one generate gives for the seed, and a long sequence can be made a
+    /// part at a time by moving firstPuzzle on.
+    /// \param seed The seed, the same seed always gives the same puzzles.
+    /// \param numberOfPuzzles The number of puzzles to make.
+    /// \param puzzles Resized to hold the puzzles, each 81 characters holding the values row by row
+    /// with '.' for no value, as read by BatchSolver.
+    /// \param firstPuzzle The number in the sequence of the first puzzle to make.
+    /// \param clues If not null, resized to hold the number of values in each puzzle.
+    /// \return The number of puzzles with more values than numberOfClues, as no puzzle with that
+    /// few was found.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    std::size_t generate( std::uint64_t seed, std::size_t numberOfPuzzles,
+      std::vector<std::string>& puzzles, std::uint64_t firstPuzzle = 0,
+      std::vector<short>* clues = nullptr );
+
+  /// Private Methods.
+  private:
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes the puzzle with the given number in the sequence for a seed.
+    /// \param solver The solver to use.
+    /// \param seed The seed.
+    /// \param number The number of the puzzle.
+    /// \param puzzle Filled with the values row by row, 0 if the grid point has no value.
+    /// \return The number of values in the puzzle.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short generatePuzzle_( SudokuBitBoard& solver, std::uint64_t seed, std::uint64_t number,
+      short (&puzzle)[SudokuTables::numberOfGridPoints] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Makes a random full board.  The boxes on the diagonal do not affect each other, so
+    /// they are filled with shuffled values and the rest of the board is solved.
+    /// \param solver The solver to use.
+    /// \param random The random number generator.
+    /// \param board Filled with the values row by row.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static void makeFullBoard_( SudokuBitBoard& solver, std::mt19937_64& random,
+      short (&board)[SudokuTables::numberOfGridPoints] );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Takes values out of a full board while it still has one solution.
+    /// \param solver The solver to use.
+    /// \param random The random number generator.
+    /// \param board The full board, left as the puzzle.
+    /// \return The number of values left.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short removeValues_( SudokuBitBoard& solver, std::mt19937_64& random,
+      short (&board)[SudokuTables::numberOfGridPoints] ) const;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the grid point that must match a grid point under the symmetry.
+    /// \param gridPoint The grid point.
+    /// \return The matching grid point, which may be gridPoint itself.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short getSymmetricGridPoint_( short gridPoint ) const;
+
+  /// Private variables.
+  private:
+    static const unsigned int maxFullBoards_ = 8; // Full boards tried to reach numberOfClues_.
+
+    short numberOfClues_; // The number of values wanted in each puzzle.
+    Symmetry symmetry_; // The symmetry of the puzzles.
+    WorkStealingPool pool_; // The threads.
+    std::vector<std::unique_ptr<SudokuBitBoard> > solvers_; // A solver for each worker.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -2,44 +2,54 @@
 #define __sudoku_sudokugridpoint_h__
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief Declaration of SudokuGridPoint.
+/// \brief Declaration of BasicSudokuGridPoint.
 /// \author anon.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
 #include <iostream>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
-#include "utilities/src/CheckIfVectorsEqual.h"
+#include "SudokuTables.h"
+#include "ValueMask.h"
 
 namespace sudoku
 {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 /// \brief Sudoku grid point contains the coordinates on a sudoku board and the value at that point.
+/// \tparam BoxSize The size of a box, i.e. 3 for a 9x9 board.
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-class SudokuGridPoint
+template<short BoxSize>
+class BasicSudokuGridPoint
 {
   public:
+    typedef BasicSudokuTables<BoxSize> Tables; // Tables for the size of board.
+    static constexpr short boardSize = Tables::boardSize; // Width of the board, and values.
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Defualt constructor. If this is used behaviour is undefined.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    SudokuGridPoint()
+    BasicSudokuGridPoint()
     {
       x_ = 0;
       y_ = 0;
       initialValue_ = 0;
       guessValue_ = 0;
+      possibleValues_ = 0;
+      clearRemovedValues_();
     }
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief SudokuGridPoint constructor.
     ///
-    /// \param x The x coordinate on the board (0 to 8).
-    /// \param y The y coordinate on the board (0 to 8).
-    /// \param value The value at (x,y).  Valid values: 1 to 9.
+    /// \param x The x coordinate on the board (0 to boardSize - 1).
+    /// \param y The y coordinate on the board (0 to boardSize - 1).
+    /// \param value The value at (x,y).  Valid values: 1 to boardSize.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    SudokuGridPoint(short x, short y, short value)
+    BasicSudokuGridPoint(short x, short y, short value)
     {
       checkXYInBounds(x, y);
 
@@ -48,9 +58,9 @@ class SudokuGridPoint
       {
         throw std::invalid_argument("Cannot specify value <= 0.");
       }
-      else if ( value > 9 )
+      else if ( value > boardSize )
       {
-        throw std::invalid_argument("Cannot specify a value > 9.");
+        throw std::invalid_argument("Cannot specify a value > " + std::to_string(boardSize) + ".");
       }
 
       // Input seems OK.
@@ -58,27 +68,81 @@ class SudokuGridPoint
       y_ = y;
       initialValue_ = value;
       guessValue_ = 0;
+      possibleValues_ = 0;
+      clearRemovedValues_();
     }
     
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief SudokuGridPoint constructor.
     ///
-    /// \param x The x coordinate on the board (0 to 8).
-    /// \param y The y coordinate on the board (0 to 8).
+    /// \param x The x coordinate on the board (0 to boardSize - 1).
+    /// \param y The y coordinate on the board (0 to boardSize - 1).
     /// \param possibleValues The possible values the value at this coordinate could be.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    SudokuGridPoint(short x, short y, std::vector<short> possibleValues) : SudokuGridPoint(x, y, 1)
+    BasicSudokuGridPoint(short x, short y, std::vector<short> possibleValues) :
+      BasicSudokuGridPoint(x, y, 1)
     { 
       // initialValue_ to be 1 for the time being, change afterwards.
       checkVectorOfPossibleValues(possibleValues);     
  
-      std::copy(possibleValues.begin(), possibleValues.end(),
-        std::back_inserter(possibleValues_));
+      for ( short v : possibleValues )
+      {
+        possibleValues_ |= valueToMask(v);
+      }
       
       guessValue_ = 0;
       initialValue_ = 0;
     }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Creates a SudokuGridPoint from a mask of possible values.  Avoids building a vector
+    /// when the possible values are already known as a mask.
+    ///
+    /// \param x The x coordinate on the board (0 to boardSize - 1).
+    /// \param y The y coordinate on the board (0 to boardSize - 1).
+    /// \param possibleValues The mask of possible values the value at this coordinate could be.
+    /// \return The SudokuGridPoint.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static BasicSudokuGridPoint withPossibleValues(short x, short y, ValueMask possibleValues)
+    {
+      BasicSudokuGridPoint result(x, y, 1);
+
+      if ( possibleValues == 0 )
+      {
+        throw std::invalid_argument("Possible values cannot be empty.");
+      }
+      else if ( ( possibleValues & ~allValuesMask(boardSize) ) != 0 )
+      {
+        throw std::invalid_argument("Cannot specify a possible value > " +
+          std::to_string(boardSize) + ".");
+      }
+
+      result.possibleValues_ = possibleValues;
+      result.initialValue_ = 0;
+      return result;
+    }
     
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Takes away any value and sets the possible values, for example after a value is
+    /// placed at or erased from a peer.  Where values were removed from is forgotten.
+    ///
+    /// \param possibleValues The mask of possible values, 0 if the grid point can have no value.
+    /// \throws invalid_argument If a possible value is > boardSize.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void resetPossibleValues(ValueMask possibleValues)
+    {
+      if ( ( possibleValues & ~allValuesMask(boardSize) ) != 0 )
+      {
+        throw std::invalid_argument("Cannot specify a possible value > " +
+          std::to_string(boardSize) + ".");
+      }
+
+      initialValue_ = 0;
+      guessValue_ = 0;
+      possibleValues_ = possibleValues;
+      clearRemovedValues_();
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief gets the x ordinate.
     /// \return the x ordinate.
@@ -116,13 +180,47 @@ class SudokuGridPoint
     }
     
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    /// \brief get the possible values.
-    /// \return the possible values.
+    /// \brief get the possible values.  This builds a vector from the mask of possible values, so
+    /// prefer getPossibleValuesMask() where possible.
+    /// \return the possible values, in ascending order.
     ////////////////////////////////////////////////////////////////////////////////////////////////
     std::vector<short> getPossibleValues() const
+    {
+      std::vector<short> possibleValues;
+      for ( ValueMask m(possibleValues_); m != 0; m &= m - 1 )
+      {
+        possibleValues.push_back(lowestValue(m));
+      }
+      return possibleValues;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief get the possible values as a mask.
+    /// \return the mask of possible values.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    ValueMask getPossibleValuesMask() const
     {
       return possibleValues_;
     }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief get the number of possible values.
+    /// \return the number of possible values.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    short getNumberOfPossibleValues() const
+    {
+      return countValues(possibleValues_);
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief checks if a value is one of the possible values.
+    /// \param value The value to check.
+    /// \return true if value is a possible value, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool hasPossibleValue(const short value) const
+    {
+      return ( possibleValues_ & valueToMask(value) ) != 0;
+    }
     
     //
     // \brief Remove a value from the possible values.  It is not guaranteed that the value will be
@@ -143,26 +241,21 @@ class SudokuGridPoint
       short result(2);
 
       //
-      // Checks if in the same column or row.  Then checks if they are in the same sudoku box.
-      // x - (x % 3) is a way of getting to the nearest multiple of 3 less than or equal to x.
+      // Checks if in the same column, row or sudoku box.
       //
-      if (   x_ == x
-          || y_ == y
-          || ((x_ - (x_ % 3)) == (x - (x % 3))
-          && (y_ - (y_ % 3)) == (y - (y % 3))) )
+      if ( Tables::sharesUnit(x_ * boardSize + y_, x * boardSize + y) )
       {      
         //
         // Now check if the value is actually in the possibleValues.
         //
-        std::vector<short>::iterator itPos(std::remove(possibleValues_.begin(),
-          possibleValues_.end(), value));
+        const ValueMask valueMask(valueToMask(value));
         
-        if ( itPos != possibleValues_.end() )
+        if ( ( possibleValues_ & valueMask ) != 0 )
         {
           // It is in the possible values, however, if it is the last value and the x and y passed
           // to this method differ from this grid point then we shouldn't remove it and return
           // a value indicating this.
-          if ( possibleValues_.size() == 1 && ! ( x == x_ && y == y_ ) )
+          if ( possibleValues_ == valueMask && ! ( x == x_ && y == y_ ) )
           {
             result = 3;
           }
@@ -172,22 +265,20 @@ class SudokuGridPoint
           //
           if ( result != 3 )
           {
-            possibleValues_.erase(itPos, possibleValues_.end());
+            possibleValues_ &= ~valueMask;
           
             // 
-            // Now add to the removed values.
+            // Now record where the value was removed from.
             // 
-            removedValues_.push_back(RemovedValueInfo_());
-            removedValues_.back().removedX = x;
-            removedValues_.back().removedY = y;
-            removedValues_.back().removedValue = value;
+            removedValues_[value - 1].removedX = x;
+            removedValues_[value - 1].removedY = y;
 
             result = 1;
           }
         }
       }
     
-      if ( result == 1 && possibleValues_.size() == 0 )
+      if ( result == 1 && possibleValues_ == 0 )
       {
         // 
         // If we have no values left in the possible values this must be our guess.
@@ -212,27 +303,21 @@ class SudokuGridPoint
       bool result(false);
 
       // If we gave an initial value then we cannot restore a value to the possible values.
-      if( initialValue_ == 0 )
+      if( initialValue_ == 0 && value >= 1 && value <= boardSize )
       {
-        RemovedValueInfo_ valueInfo = RemovedValueInfo_();
-        valueInfo.removedX = x;
-        valueInfo.removedY = y;
-        valueInfo.removedValue = value;
-
-        // Find if we removed the value previously.
-        std::vector<RemovedValueInfo_>::iterator itPos(std::remove(removedValues_.begin(),
-          removedValues_.end(), valueInfo));
+        RemovedValueInfo_& valueInfo(removedValues_[value - 1]);
 
-        // If we have then we can restore it.
-        if ( itPos != removedValues_.end() )
+        // If we removed the value previously from x and y then we can restore it.
+        if ( valueInfo.removedX == x && valueInfo.removedY == y )
         {
           // We have restored a possible value, make sure the guess is back to being 0.
           guessValue_ = 0;
           // Now to add the value to possible values.
-          possibleValues_.push_back(value);
+          possibleValues_ |= valueToMask(value);
 
-          // Since it was in the vector of removed values we had better remove it.
-          removedValues_.erase(itPos, removedValues_.end());
+          // It is no longer removed.
+          valueInfo.removedX = -1;
+          valueInfo.removedY = -1;
           
           result = true;
         }
@@ -240,19 +325,44 @@ class SudokuGridPoint
       return result;
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Removes a possible value without recording where it was removed from, for a solver
+    /// that keeps its own record to undo.  If it was the last possible value it becomes the guess.
+    /// \param value The value, which must be a possible value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void removePossibleValue(short value)
+    {
+      possibleValues_ &= ~valueToMask(value);
+      if ( possibleValues_ == 0 )
+      {
+        guessValue_ = value;
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Restores a possible value removed by removePossibleValue(short), so there is no
+    /// guess.
+    /// \param value The value, which must not be a possible value.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void restorePossibleValue(short value)
+    {
+      possibleValues_ |= valueToMask(value);
+      guessValue_ = 0;
+    }
+
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief Equality operator.
     /// \param rhs The right hand side object.
     /// \return true if number of possible values are equal, but if initial values were provided
     /// then trivially equal, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator==(const SudokuGridPoint& rhs) const
+    bool operator==(const BasicSudokuGridPoint& rhs) const
     {
       bool result(false);
       if ( ( initialValue_ == 0 && rhs.initialValue_ == 0 ) ||
            ( initialValue_ != 0 && rhs.initialValue_ != 0 ) )
       { 
-        if ( possibleValues_.size() == rhs.possibleValues_.size() )
+        if ( countValues(possibleValues_) == countValues(rhs.possibleValues_) )
         {
           result = true;
         }
@@ -267,7 +377,7 @@ class SudokuGridPoint
     /// that objects initialised with initial values are less than objects that have possible
     /// values, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator<(const SudokuGridPoint& rhs) const
+    bool operator<(const BasicSudokuGridPoint& rhs) const
     {
       bool result(false);
       if ( initialValue_ != 0)
@@ -279,7 +389,7 @@ class SudokuGridPoint
       }
       else
       {
-        if ( possibleValues_.size() < rhs.possibleValues_.size() )
+        if ( countValues(possibleValues_) < countValues(rhs.possibleValues_) )
         {
           result = true;
         }
@@ -294,7 +404,7 @@ class SudokuGridPoint
     /// note that objects initialised with initial values are not equal to objects initialised
     /// with possible values, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator!=(const SudokuGridPoint& rhs) const
+    bool operator!=(const BasicSudokuGridPoint& rhs) const
     {
       return ! ( *this == rhs );
     }
@@ -306,7 +416,7 @@ class SudokuGridPoint
     /// the rhs, note that objects initialised with initial values are less than or equal to objects
     /// initialised with possible values, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator<=(const SudokuGridPoint& rhs) const
+    bool operator<=(const BasicSudokuGridPoint& rhs) const
     {
       return ( *this == rhs ) || ( *this < rhs );
     }
@@ -318,7 +428,7 @@ class SudokuGridPoint
     /// the rhs, note that objects initialised with initial values not greater than objects
     /// initialised with possible values, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator>(const SudokuGridPoint& rhs) const
+    bool operator>(const BasicSudokuGridPoint& rhs) const
     {
       return ! ( *this <= rhs );
     }
@@ -330,7 +440,7 @@ class SudokuGridPoint
     /// the rhs, note that objects initialised with initial values are not greater than or equal to
     /// objects initialised with possible values, false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool operator>=(const SudokuGridPoint& rhs) const
+    bool operator>=(const BasicSudokuGridPoint& rhs) const
     {
       return ! ( *this < rhs );
     }
@@ -339,46 +449,20 @@ class SudokuGridPoint
     /// \brief Gets the affected grid points.  This will need explaining.
     /// We have a grid point, given by x, y on the sudoku board.  If this grid point has a value
     /// then none of the values in the same row, column or 'box' can have the same value. With this
-    /// method we return a vector of pairs of these other grid points.
+    /// method we return a vector of pairs of these other grid points.  Code that needs these often
+    /// should use Tables::getPeers instead.
     /// \return See decription.
     ////////////////////////////////////////////////////////////////////////////////////////////////
     std::vector<std::pair<short, short> > getAffectedGridPoints() const
     {
       std::vector<std::pair<short, short> > affectedGridPoints;
-      
-      // Get affected grid points from row.
-      for ( short i = 0; i < 9; ++i )
-      {
-        // Don't add this grid point.
-        if ( i != x_ )
-        {
-          affectedGridPoints.push_back(std::make_pair(i, y_));
-        }
-      }
 
-      // Get affected grid points from column.
-      for ( short j(0); j < 9; ++j )
-      {
-        // Don't add this grid point.
-        if ( j != y_ )
-        {
-          affectedGridPoints.push_back(std::make_pair(x_, j));
-        }
-      }
-      
-      short startX(x_ - (x_ % 3));
-      short startY(y_ - (y_ % 3));
+      // The affected grid points are the peers in the tables, which do not need building.
+      const typename Tables::Index* peers(Tables::getPeers(x_ * boardSize + y_));
 
-      // Get affected grid points from sudoku box.
-      for ( short i(startX); i < startX + 3; ++i )
+      for ( short i(0); i < Tables::numberOfPeers; ++i )
       {
-        for ( short j(startY); j < startY + 3; ++j )
-        {
-          if ( i != x_ && j != y_ )
-          {
-            affectedGridPoints.push_back(std::make_pair(i, j));
-          }
-        }
+        affectedGridPoints.push_back(std::make_pair(peers[i] / boardSize, peers[i] % boardSize));
       }
 
       return affectedGridPoints;
@@ -386,17 +470,17 @@ class SudokuGridPoint
 
     ////////////////////////////////////////////////////////////////////////////////////////////////
     /// \brief The shallowEquals method.  Shallow since we only compare x, y, the value and 
-    /// the vector of possible values (i.e. things that are available publically).
+    /// the possible values (i.e. things that are available publically).
     /// \param rhs The other object we are comapring to.
     /// \return true is equal (shallowy) false otherwise.
     ////////////////////////////////////////////////////////////////////////////////////////////////
-    bool shallowEquals(const SudokuGridPoint& rhs) const
+    bool shallowEquals(const BasicSudokuGridPoint& rhs) const
     {
       bool result(false);
       if ( this->getX() == rhs.getX() &&
            this->getY() == rhs.getY() &&
            this->getValue() == rhs.getValue() &&
-           utilities::checkIfVectorsEqual(this->getPossibleValues(), rhs.getPossibleValues()))
+           this->getPossibleValuesMask() == rhs.getPossibleValuesMask() )
       {
         result = true;
       }
@@ -417,9 +501,10 @@ class SudokuGridPoint
       {
         throw std::invalid_argument("Cannot specify a negative x ordinate.");
       }
-      else if ( x > 8 )
+      else if ( x > boardSize - 1 )
       {
-        throw std::invalid_argument("Cannot specify an x ordinate > 8.");
+        throw std::invalid_argument("Cannot specify an x ordinate > " +
+          std::to_string(boardSize - 1) + ".");
       }
 
       // Check y ordinate in correct bounds.
@@ -427,9 +512,10 @@ class SudokuGridPoint
       {
         throw std::invalid_argument("Cannot specify a negative y ordinate.");
       }
-      else if ( y > 8 )
+      else if ( y > boardSize - 1 )
       {
-        throw std::invalid_argument("Cannot specify an y ordinate > 8.");
+        throw std::invalid_argument("Cannot specify an y ordinate > " +
+          std::to_string(boardSize - 1) + ".");
       }
     }
 
@@ -451,9 +537,10 @@ class SudokuGridPoint
         {
           throw std::invalid_argument("Cannot specify a possible value <= 0.");
         }
-        else if ( v > 9 )
+        else if ( v > boardSize )
         {
-          throw std::invalid_argument("Cannot specify a possible value > 9.");
+          throw std::invalid_argument("Cannot specify a possible value > " +
+            std::to_string(boardSize) + ".");
         }
       }
 
@@ -465,31 +552,42 @@ class SudokuGridPoint
       }
     }
 
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Marks every value as not removed.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void clearRemovedValues_()
+    {
+      for ( RemovedValueInfo_& info : removedValues_ )
+      {
+        info.removedX = -1;
+        info.removedY = -1;
+      }
+    }
+
   // Private variables.
   private:
-    // Struct that contains information about a removed value from possible values.
+    // Struct that contains where a value was removed from possible values.  -1 if not removed.
     struct RemovedValueInfo_
     {
-      short removedValue;
       short removedX;
       short removedY;
-
-      // Need equals operator for restoring to possible values.
-      bool operator==(const RemovedValueInfo_& rhs) const
-      {
-        return ( removedValue == rhs.removedValue ) &&
-               ( removedX == rhs.removedX ) &&
-               ( removedY == rhs.removedY );
-      }
     };
 
     short x_; // The x ordinate.
     short y_; // The y ordinate.
     short initialValue_; // The value at the coordinates on the Sudoku board.
     short guessValue_; // The value we have guessed once we have one value in possible values.
-    std::vector<short> possibleValues_; // Vector of possible values.
-    std::vector<RemovedValueInfo_> removedValues_; // Vector of removed possible values.
+    ValueMask possibleValues_; // Mask of possible values.
+    // Where each removed possible value was removed from, indexed by value - 1.  A value can only
+    // be removed once before it is restored, so one entry per value is enough.
+    RemovedValueInfo_ removedValues_[boardSize];
 };
+
+template<short BoxSize>
+constexpr short BasicSudokuGridPoint<BoxSize>::boardSize;
+
+// Grid point of the standard 9x9 board.
+typedef BasicSudokuGridPoint<3> SudokuGridPoint;
  
 } // End of namespace sudoku.
 
@@ -0,0 +1,145 @@
+#ifndef __sudoku_sudokutables_h__
+#define __sudoku_sudokutables_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of BasicSudokuTables.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <type_traits>
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief BasicSudokuTables contains tables, built at compile time, describing which grid points
+/// of a Sudoku board affect each other.  Grid points are numbered row by row, so (x,y) is
+/// x * boardSize + y.  Units are numbered with the rows first (x fixed), then the columns (y fixed)
+/// and then the boxes.
+/// \tparam BoxSize The size of a box, i.e. 3 for a 9x9 board.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+class BasicSudokuTables
+{
+  public:
+    static constexpr short boxSize = BoxSize; // Size of a box.
+    static constexpr short boardSize = BoxSize * BoxSize; // Width of the board, and values.
+    static constexpr short numberOfGridPoints = boardSize * boardSize; // Grid points on board.
+    static constexpr short numberOfUnits = 3 * boardSize; // Rows, columns and boxes.
+    static constexpr short numberOfPeers = 3 * boardSize - 2 * BoxSize - 1; // Peers of each point.
+
+    // Type used to hold the index of a grid point.
+    typedef typename std::conditional<( numberOfGridPoints <= 256 ), unsigned char,
+      unsigned short>::type Index;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the peers of a grid point, i.e. the other grid points in the same row, column
+    /// or box.
+    /// \param gridPoint The index of the grid point.
+    /// \return Array of numberOfPeers grid point indices, in ascending order.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static constexpr const Index* getPeers(const short gridPoint)
+    {
+      return tables_.peers[gridPoint];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the grid points in a unit.
+    /// \param unit The index of the unit.
+    /// \return Array of boardSize grid point indices.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static constexpr const Index* getUnit(const short unit)
+    {
+      return tables_.units[unit];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the units a grid point is in.
+    /// \param gridPoint The index of the grid point.
+    /// \return Array of the row, column and box unit indices.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static constexpr const short* getUnitsOf(const short gridPoint)
+    {
+      return tables_.unitsOf[gridPoint];
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Checks if two grid points are in the same row, column or box.
+    /// \param lhs The index of one grid point.
+    /// \param rhs The index of the other grid point.
+    /// \return true if they share a unit (including if they are the same grid point).
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static constexpr bool sharesUnit(const short lhs, const short rhs)
+    {
+      return tables_.unitsOf[lhs][0] == tables_.unitsOf[rhs][0] ||
+             tables_.unitsOf[lhs][1] == tables_.unitsOf[rhs][1] ||
+             tables_.unitsOf[lhs][2] == tables_.unitsOf[rhs][2];
+    }
+
+  // Private types and methods.
+  private:
+    // Struct holding all of the tables.
+    struct Tables_
+    {
+      Index peers[numberOfGridPoints][numberOfPeers];
+      Index units[numberOfUnits][boardSize];
+      short unitsOf[numberOfGridPoints][3];
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Builds the tables, evaluated at compile time.
+    /// \return The tables.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    static constexpr Tables_ makeTables_()
+    {
+      Tables_ tables {};
+
+      for ( short gridPoint(0); gridPoint < numberOfGridPoints; ++gridPoint )
+      {
+        const short x(gridPoint / boardSize);
+        const short y(gridPoint % boardSize);
+        const short box(( x / BoxSize ) * BoxSize + y / BoxSize);
+        const short positionInBox(( x % BoxSize ) * BoxSize + y % BoxSize);
+
+        tables.unitsOf[gridPoint][0] = x;
+        tables.unitsOf[gridPoint][1] = boardSize + y;
+        tables.unitsOf[gridPoint][2] = 2 * boardSize + box;
+
+        tables.units[x][y] = static_cast<Index>(gridPoint);
+        tables.units[boardSize + y][x] = static_cast<Index>(gridPoint);
+        tables.units[2 * boardSize + box][positionInBox] = static_cast<Index>(gridPoint);
+      }
+
+      for ( short gridPoint(0); gridPoint < numberOfGridPoints; ++gridPoint )
+      {
+        short numberFound(0);
+        for ( short other(0); other < numberOfGridPoints; ++other )
+        {
+          if ( other != gridPoint &&
+               ( tables.unitsOf[gridPoint][0] == tables.unitsOf[other][0] ||
+                 tables.unitsOf[gridPoint][1] == tables.unitsOf[other][1] ||
+                 tables.unitsOf[gridPoint][2] == tables.unitsOf[other][2] ) )
+          {
+            tables.peers[gridPoint][numberFound++] = static_cast<Index>(other);
+          }
+        }
+      }
+
+      return tables;
+    }
+
+  // Private variables.
+  private:
+    static const Tables_ tables_; // The tables, defined below once makeTables_ is complete.
+};
+
+template<short BoxSize>
+constexpr typename BasicSudokuTables<BoxSize>::Tables_ BasicSudokuTables<BoxSize>::tables_ =
+  BasicSudokuTables<BoxSize>::makeTables_();
+
+// Tables for the standard 9x9 board.
+typedef BasicSudokuTables<3> SudokuTables;
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef __sudoku_valuemask_h__
+#define __sudoku_valuemask_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of ValueMask and helpers for manipulating sets of Sudoku values.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief A set of Sudoku values held as bits, value v is in the set if bit (v - 1) is set.  32
+/// bits is enough for boards with up to 32 values.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+typedef unsigned int ValueMask;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the mask containing only the given value.
+/// \param value The value (1 to 32).
+/// \return The mask with just the bit for value set.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline ValueMask valueToMask(const short value)
+{
+  return static_cast<ValueMask>(1) << (value - 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the mask containing all the values 1 to numberOfValues.
+/// \param numberOfValues The number of values (1 to 32).
+/// \return The mask with the lowest numberOfValues bits set.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline ValueMask allValuesMask(const short numberOfValues)
+{
+  return numberOfValues >= 32 ? ~static_cast<ValueMask>(0) :
+    ( static_cast<ValueMask>(1) << numberOfValues ) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the values in a mask.
+/// \param mask The mask.
+/// \return The number of values in the mask.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline short countValues(const ValueMask mask)
+{
+  return static_cast<short>(__builtin_popcount(mask));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Gets the lowest value in a mask.  To iterate over a mask use:
+///   for ( ValueMask m(mask); m != 0; m &= m - 1 ) { short value(lowestValue(m)); ... }
+/// \param mask The mask, must not be 0.
+/// \return The lowest value in the mask.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+inline short lowestValue(const ValueMask mask)
+{
+  return static_cast<short>(__builtin_ctz(mask) + 1);
+}
+
+} // End of namespace sudoku.
+
+#endif
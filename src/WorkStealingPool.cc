@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of WorkStealingPool.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "WorkStealingPool.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+WorkStealingPool::WorkStealingPool( unsigned int numberOfWorkers )
+  : numberOfWorkers_(numberOfWorkers != 0 ? numberOfWorkers : std::thread::hardware_concurrency())
+{
+  if ( numberOfWorkers_ == 0 )
+  {
+    // The number of hardware threads is not known.
+    numberOfWorkers_ = 1;
+  }
+  ranges_.reset(new Range_[numberOfWorkers_]);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPool::run( std::size_t numberOfTasks, const Task& task )
+{
+  // Share the tasks out evenly.
+  for ( unsigned int worker(0); worker < numberOfWorkers_; ++worker )
+  {
+    ranges_[worker].begin = numberOfTasks * worker / numberOfWorkers_;
+    ranges_[worker].end = numberOfTasks * ( worker + 1 ) / numberOfWorkers_;
+  }
+
+  std::mutex exceptionMutex;
+  std::exception_ptr exception;
+
+  // Catch exceptions from the tasks, keeping the first.
+  const Task guardedTask(
+    [&task, &exceptionMutex, &exception]( unsigned int worker, std::size_t taskNumber )
+    {
+      try
+      {
+        task(worker, taskNumber);
+      }
+      catch ( ... )
+      {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if ( ! exception )
+        {
+          exception = std::current_exception();
+        }
+      }
+    });
+
+  std::vector<std::thread> threads;
+  threads.reserve(numberOfWorkers_ - 1);
+  for ( unsigned int worker(1); worker < numberOfWorkers_; ++worker )
+  {
+    threads.emplace_back(&WorkStealingPool::work_, this, worker, std::cref(guardedTask));
+  }
+
+  work_(0, guardedTask);
+
+  for ( auto &thread : threads )
+  {
+    thread.join();
+  }
+
+  if ( exception )
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPool::work_( unsigned int worker, const Task& task )
+{
+  std::size_t taskNumber(0);
+
+  // Tasks are never added, only moved between workers, so once there is nothing to steal every
+  // task has been taken.
+  while ( true )
+  {
+    if ( takeTask_(worker, taskNumber) )
+    {
+      task(worker, taskNumber);
+    }
+    else if ( ! stealTasks_(worker) )
+    {
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingPool::takeTask_( unsigned int worker, std::size_t& taskNumber )
+{
+  Range_& range(ranges_[worker]);
+  std::lock_guard<std::mutex> lock(range.mutex);
+
+  if ( range.begin == range.end )
+  {
+    return false;
+  }
+
+  taskNumber = range.begin++;
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool WorkStealingPool::stealTasks_( unsigned int worker )
+{
+  for ( unsigned int i(1); i < numberOfWorkers_; ++i )
+  {
+    Range_& victim(ranges_[( worker + i ) % numberOfWorkers_]);
+    std::size_t begin(0);
+    std::size_t end(0);
+
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if ( victim.begin == victim.end )
+      {
+        continue;
+      }
+
+      // Take the back half, rounding up so a single task can be stolen.
+      begin = victim.end - ( victim.end - victim.begin + 1 ) / 2;
+      end = victim.end;
+      victim.end = begin;
+    }
+
+    Range_& range(ranges_[worker]);
+    std::lock_guard<std::mutex> lock(range.mutex);
+    range.begin = begin;
+    range.end = end;
+    return true;
+  }
+
+  return false;
+}
+
+} // End of namespace sudoku.
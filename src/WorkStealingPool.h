@@ -0,0 +1,93 @@
+#ifndef __sudoku_workstealingpool_h__
+#define __sudoku_workstealingpool_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of WorkStealingPool.
+/// \author anon.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief WorkStealingPool runs numbered tasks on several threads.  Each worker starts with an
+/// equal share of the tasks, as a range of task numbers, and runs them from the front of its range.
+/// A worker that runs out steals the back half of another worker's range, so a few slow tasks do
+/// not leave the other workers idle.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class WorkStealingPool
+{
+  public:
+    // A task, called with the number of the worker running it and the number of the task.
+    typedef std::function<void( unsigned int worker, std::size_t task )> Task;
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief WorkStealingPool constructor.
+    /// \param numberOfWorkers The number of workers, 0 for one per hardware thread.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    explicit WorkStealingPool( unsigned int numberOfWorkers = 0 );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Gets the number of workers.
+    /// \return The number of workers.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    unsigned int getNumberOfWorkers() const
+    {
+      return numberOfWorkers_;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Runs tasks 0 to numberOfTasks - 1, each once, and waits for them to finish.  The
+    /// calling thread is worker 0.  If a task throws, the remaining tasks are still run and the
+    /// first exception is thrown again once they have finished.
+    /// \param numberOfTasks The number of tasks.
+    /// \param task The task to run.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void run( std::size_t numberOfTasks, const Task& task );
+
+  /// Private types and methods.
+  private:
+    // Struct holding the task numbers a worker has still to run, [begin, end).
+    struct Range_
+    {
+      std::mutex mutex; // Protects begin and end, which other workers change when stealing.
+      std::size_t begin; // Next task to run.
+      std::size_t end; // One past the last task.
+    };
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Runs tasks until there are none left to run or steal.
+    /// \param worker The number of the worker.
+    /// \param task The task to run.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    void work_( unsigned int worker, const Task& task );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Takes the next task from the front of a worker's own range.
+    /// \param worker The number of the worker.
+    /// \param taskNumber Set to the task number, if there is one.
+    /// \return true if there was a task, false otherwise.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool takeTask_( unsigned int worker, std::size_t& taskNumber );
+
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// \brief Steals the back half of another worker's range into a worker's empty range.
+    /// \param worker The number of the worker that is stealing.
+    /// \return true if any tasks were stolen, false if every other worker's range is empty.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    bool stealTasks_( unsigned int worker );
+
+  /// Private variables.
+  private:
+    unsigned int numberOfWorkers_; // Number of workers.
+    std::unique_ptr<Range_[]> ranges_; // The range of each worker.
+};
+ 
+} // End of namespace sudoku.
+
+#endif
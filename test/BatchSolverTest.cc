@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for BatchSolver.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <unistd.h>
+
+#include "src/BatchSolver.h"
+#include "BatchSolverTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::BatchSolverTest );
+
+// The shared boards written as lines.
+const std::string testBoard(sudoku::testboards::toText(sudoku::testboards::testBoard));
+const std::string testBoardSolution(
+  sudoku::testboards::toText(sudoku::testboards::testBoardSolution));
+const std::string alEscargot(sudoku::testboards::toText(sudoku::testboards::alEscargot, '0'));
+const std::string alEscargotSolution(
+  sudoku::testboards::toText(sudoku::testboards::alEscargotSolution));
+const std::string nonSolvableTestBoard(
+  sudoku::testboards::toText(sudoku::testboards::nonSolvableTestBoard, '0'));
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::testSolvingPuzzles()
+{
+  const std::vector<std::string> puzzles { testBoard, alEscargot, nonSolvableTestBoard };
+  std::vector<std::string> solutions;
+
+  subject_->solve(puzzles, solutions);
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(3), solutions.size() );
+  CPPUNIT_ASSERT_EQUAL( testBoardSolution, solutions[0] );
+  CPPUNIT_ASSERT_EQUAL( alEscargotSolution, solutions[1] );
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::noSolution, solutions[2] );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::testSolutionsInInputOrder()
+{
+  std::vector<std::string> puzzles;
+  std::vector<std::string> solutions;
+
+  for ( short i(0); i < 1000; ++i )
+  {
+    puzzles.push_back(( i % 7 == 0 ) ? alEscargot :
+                      ( i % 3 == 0 ) ? nonSolvableTestBoard : testBoard);
+  }
+
+  subject_->solve(puzzles, solutions);
+
+  CPPUNIT_ASSERT_EQUAL( puzzles.size(), solutions.size() );
+  for ( short i(0); i < 1000; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( ( i % 7 == 0 ) ? alEscargotSolution :
+                          ( i % 3 == 0 ) ? BatchSolver::noSolution : testBoardSolution,
+                          solutions[i] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::testSolvingStream()
+{
+  // Three puzzles at a time.
+  BatchSolver batchSolver(2, 3);
+  std::istringstream input(testBoard + "\n" + alEscargot + "\r\n" + nonSolvableTestBoard + "\n" +
+    alEscargot + "\n" + testBoard);
+  std::ostringstream output;
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(5), batchSolver.solve(input, output) );
+  CPPUNIT_ASSERT_EQUAL( testBoardSolution + "\n" + alEscargotSolution + "\n" +
+    BatchSolver::noSolution + "\n" + alEscargotSolution + "\n" + testBoardSolution + "\n",
+    output.str() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::testSolvingFile()
+{
+  const std::string path("/tmp/BatchSolverTest." + std::to_string(getpid()));
+  {
+    std::ofstream file(path.c_str(), std::ios::binary);
+    file << testBoard + "\n" + alEscargot + "\r\n" + nonSolvableTestBoard + "\n" + "x\n" +
+      alEscargot + "\n" + testBoard + "\n";
+  }
+
+  // Three puzzles at a time, so the last chunk is full.
+  BatchSolver batchSolver(2, 3);
+  PuzzleFile input(path);
+  std::ostringstream output;
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(6), batchSolver.solve(input, output) );
+  CPPUNIT_ASSERT_EQUAL( testBoardSolution + "\n" + alEscargotSolution + "\n" +
+    BatchSolver::noSolution + "\n" + BatchSolver::invalidPuzzle + "\n" + alEscargotSolution +
+    "\n" + testBoardSolution + "\n", output.str() );
+
+  (void)std::remove(path.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::testInvalidPuzzles()
+{
+  std::string clashing(testBoard);
+  // 3 is already at (0,8).
+  clashing[0] = '3';
+  std::string badCharacter(testBoard);
+  badCharacter[40] = 'x';
+
+  const std::vector<std::string> puzzles { "", testBoard.substr(1), testBoard + "0", badCharacter,
+                                           clashing };
+  std::vector<std::string> solutions;
+
+  subject_->solve(puzzles, solutions);
+
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::invalidPuzzle, solutions[0] );
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::invalidPuzzle, solutions[1] );
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::invalidPuzzle, solutions[2] );
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::invalidPuzzle, solutions[3] );
+  CPPUNIT_ASSERT_EQUAL( BatchSolver::noSolution, solutions[4] );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+boost::shared_ptr<BatchSolver> BatchSolverTest::createSubject()
+{
+  boost::shared_ptr<BatchSolver> subject(new BatchSolver(4));
+  return subject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void BatchSolverTest::setUp()
+{
+  subject_ = createSubject();
+}
+
+} // End of namespace sudoku.
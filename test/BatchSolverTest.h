@@ -0,0 +1,68 @@
+#ifndef __sudoku_batchsolvertest_h__
+#define __sudoku_batchsolvertest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for BatchSolver.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/shared_ptr.hpp>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/BatchSolver.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief BatchSolverTest class for testing BatchSolver.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class BatchSolverTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(BatchSolverTest);
+  CPPUNIT_TEST(testSolvingPuzzles);
+  CPPUNIT_TEST(testSolutionsInInputOrder);
+  CPPUNIT_TEST(testSolvingStream);
+  CPPUNIT_TEST(testSolvingFile);
+  CPPUNIT_TEST(testInvalidPuzzles);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    //void tearDown();
+
+    /// \test Test solving puzzles with one, several and no solutions.
+    void testSolvingPuzzles();
+
+    /// \test Test the solutions of many puzzles are in the same order as the puzzles.
+    void testSolutionsInInputOrder();
+
+    /// \test Test solving puzzles read from a stream, across several chunks.
+    void testSolvingStream();
+
+    /// \test Test solving puzzles read from a PuzzleFile, across several chunks.
+    void testSolvingFile();
+
+    /// \test Test lines that are not puzzles.
+    void testInvalidPuzzles();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<BatchSolver> subject_; // subject used for testing.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<BatchSolver> createSubject(); // Method used to create subject.
+};
+
+} // End of namespace sudoku.
+
+#endif
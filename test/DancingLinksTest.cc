@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for DancingLinks.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+
+#include "src/DancingLinks.h"
+#include "DancingLinksTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::DancingLinksTest );
+
+namespace sudoku
+{
+
+using testboards::alEscargot;
+using testboards::alEscargotSolution;
+using testboards::checkSolution;
+using testboards::nonSolvableTestBoard;
+using testboards::testBoard;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testSolvingGoodBoard()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(testBoard, solution) );
+  CPPUNIT_ASSERT( checkSolution(testBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testSolvingAlEscargot()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, alEscargotSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testSolvingZeroesBoard()
+{
+  const short zeroesBoard[81] = { 0 };
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(zeroesBoard, solution) );
+  CPPUNIT_ASSERT( checkSolution(zeroesBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testClashingValuesNotSolvable()
+{
+  short board[81];
+  short solution[81];
+
+  std::copy(testBoard, testBoard + 81, board);
+  // 3 is already at (0,8).
+  board[0] = 3;
+
+  CPPUNIT_ASSERT( ! subject_->solve(board, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testBoardValidButNotSolvable()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( ! subject_->solve(nonSolvableTestBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testReusedAfterEachSolve()
+{
+  short board[81];
+  short first[81];
+  short second[81];
+
+  std::copy(testBoard, testBoard + 81, board);
+  board[0] = 3;
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, first) );
+  CPPUNIT_ASSERT( ! subject_->solve(board, second) );
+  CPPUNIT_ASSERT( ! subject_->solve(nonSolvableTestBoard, second) );
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, second) );
+  CPPUNIT_ASSERT( std::equal(first, first + 81, second) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::testCountingNodes()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getNodes() );
+
+  // A row is chosen for each grid point without a value, and more if any choices are wrong.
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  const unsigned long nodes(subject_->getNodes());
+  CPPUNIT_ASSERT( nodes > static_cast<unsigned long>(std::count(alEscargot, alEscargot + 81, 0)) );
+
+  // Only some of the rows are guesses, the rest are forced.
+  const unsigned long guesses(subject_->getGuesses());
+  CPPUNIT_ASSERT( guesses > 0 );
+  CPPUNIT_ASSERT( guesses < nodes );
+
+  // A full board needs no rows.
+  CPPUNIT_ASSERT( subject_->solve(alEscargotSolution, solution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getNodes() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getGuesses() );
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  CPPUNIT_ASSERT_EQUAL( nodes, subject_->getNodes() );
+  CPPUNIT_ASSERT_EQUAL( guesses, subject_->getGuesses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+boost::shared_ptr<DancingLinks> DancingLinksTest::createSubject()
+{
+  boost::shared_ptr<DancingLinks> subject(new DancingLinks());
+  return subject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void DancingLinksTest::setUp()
+{
+  subject_ = createSubject();
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,76 @@
+#ifndef __sudoku_dancinglinkstest_h__
+#define __sudoku_dancinglinkstest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for DancingLinks.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/shared_ptr.hpp>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/DancingLinks.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief DancingLinksTest class for testing DancingLinks.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class DancingLinksTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(DancingLinksTest);
+  CPPUNIT_TEST(testSolvingGoodBoard);
+  CPPUNIT_TEST(testSolvingAlEscargot);
+  CPPUNIT_TEST(testSolvingZeroesBoard);
+  CPPUNIT_TEST(testClashingValuesNotSolvable);
+  CPPUNIT_TEST(testBoardValidButNotSolvable);
+  CPPUNIT_TEST(testReusedAfterEachSolve);
+  CPPUNIT_TEST(testCountingNodes);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    //void tearDown();
+
+    /// \test Test solving a good board.
+    void testSolvingGoodBoard();
+
+    /// \test Test solving the Al Escargot.
+    void testSolvingAlEscargot();
+
+    /// \test Test solving a board with no values.
+    void testSolvingZeroesBoard();
+
+    /// \test Test a board with the same value twice in a row has no solution.
+    void testClashingValuesNotSolvable();
+
+    /// \test Test a board that is valid but has no solution.
+    void testBoardValidButNotSolvable();
+
+    /// \test Test that the same object gives the same results when used again.
+    void testReusedAfterEachSolve();
+
+    /// \test Test the nodes of the search are counted for each solve.
+    void testCountingNodes();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<DancingLinks> subject_; // subject used for testing.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<DancingLinks> createSubject(); // Method used to create subject.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for PackedPuzzleFormat.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "src/PackedPuzzleFormat.h"
+#include "PackedPuzzleFormatTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::PackedPuzzleFormatTest );
+
+namespace
+{
+
+// A test board with 25 values.
+const short testBoard[81] =
+{
+0, 0, 9, 0, 0, 0, 0, 0, 3,
+0, 3, 0, 0, 5, 7, 0, 0, 0,
+0, 0, 0, 8, 0, 0, 0, 0, 4,
+2, 0, 0, 0, 0, 0, 1, 6, 0,
+0, 5, 0, 1, 7, 6, 0, 0, 0,
+0, 0, 0, 0, 0, 9, 0, 5, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0,
+8, 6, 0, 4, 1, 0, 0, 0, 9,
+0, 0, 2, 5, 0, 3, 4, 0, 0
+};
+
+// The solution of the test board.
+const short testSolution[81] =
+{
+1, 8, 9, 6, 2, 4, 5, 7, 3,
+4, 3, 6, 9, 5, 7, 8, 2, 1,
+5, 2, 7, 8, 3, 1, 6, 9, 4,
+2, 9, 4, 3, 8, 5, 1, 6, 7,
+3, 5, 8, 1, 7, 6, 9, 4, 2,
+6, 7, 1, 2, 4, 9, 3, 5, 8,
+9, 4, 3, 7, 6, 8, 2, 1, 5,
+8, 6, 5, 4, 1, 2, 7, 3, 9,
+7, 1, 2, 5, 9, 3, 4, 8, 6
+};
+
+} // End of anonymous namespace.
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testPackingPuzzles()
+{
+  char bytes[PackedPuzzleFormat::maxPuzzleSize];
+  short values[81];
+
+  // 25 values take 13 bytes after the bitmap.
+  CPPUNIT_ASSERT_EQUAL( std::size_t(24), PackedPuzzleFormat::packPuzzle(testBoard, bytes) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(24),
+    PackedPuzzleFormat::unpackPuzzle(bytes, sizeof(bytes), values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, testBoard) );
+
+  // One more value fills the last byte.
+  short puzzle[81];
+  std::copy(testBoard, testBoard + 81, puzzle);
+  puzzle[80] = 6;
+  CPPUNIT_ASSERT_EQUAL( std::size_t(24), PackedPuzzleFormat::packPuzzle(puzzle, bytes) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(24),
+    PackedPuzzleFormat::unpackPuzzle(bytes, sizeof(bytes), values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, puzzle) );
+
+  // An empty board is just the bitmap.
+  std::fill(puzzle, puzzle + 81, 0);
+  CPPUNIT_ASSERT_EQUAL( PackedPuzzleFormat::bitmapSize,
+    PackedPuzzleFormat::packPuzzle(puzzle, bytes) );
+  CPPUNIT_ASSERT_EQUAL( PackedPuzzleFormat::bitmapSize,
+    PackedPuzzleFormat::unpackPuzzle(bytes, sizeof(bytes), values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, puzzle) );
+
+  // A full board is the largest.
+  CPPUNIT_ASSERT_EQUAL( PackedPuzzleFormat::maxPuzzleSize,
+    PackedPuzzleFormat::packPuzzle(testSolution, bytes) );
+  CPPUNIT_ASSERT_EQUAL( PackedPuzzleFormat::maxPuzzleSize,
+    PackedPuzzleFormat::unpackPuzzle(bytes, sizeof(bytes), values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, testSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testPackingInvalidValues()
+{
+  char bytes[PackedPuzzleFormat::maxPuzzleSize];
+  short puzzle[81];
+  std::copy(testBoard, testBoard + 81, puzzle);
+
+  puzzle[40] = 10;
+  CPPUNIT_ASSERT_THROW( PackedPuzzleFormat::packPuzzle(puzzle, bytes), std::invalid_argument );
+  puzzle[40] = -1;
+  CPPUNIT_ASSERT_THROW( PackedPuzzleFormat::packPuzzle(puzzle, bytes), std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testUnpackingTruncatedPuzzle()
+{
+  char bytes[PackedPuzzleFormat::maxPuzzleSize];
+  short values[81];
+  const std::size_t size(PackedPuzzleFormat::packPuzzle(testBoard, bytes));
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), PackedPuzzleFormat::unpackPuzzle(bytes, size - 1, values) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0),
+    PackedPuzzleFormat::unpackPuzzle(bytes, PackedPuzzleFormat::bitmapSize - 1, values) );
+
+  // The first value is in the low half of the byte after the bitmap.
+  bytes[PackedPuzzleFormat::bitmapSize] &= 0xF0;
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), PackedPuzzleFormat::unpackPuzzle(bytes, size, values) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testPackingSolutions()
+{
+  char bytes[PackedPuzzleFormat::solutionSize];
+  short values[81];
+
+  PackedPuzzleFormat::packSolution(testSolution, bytes);
+  CPPUNIT_ASSERT( PackedPuzzleFormat::unpackSolution(bytes, values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, testSolution) );
+
+  // A solution has a value at every grid point.
+  CPPUNIT_ASSERT_THROW( PackedPuzzleFormat::packSolution(testBoard, bytes),
+    std::invalid_argument );
+
+  bytes[0] &= 0xF0;
+  CPPUNIT_ASSERT( ! PackedPuzzleFormat::unpackSolution(bytes, values) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testWritingAndReadingHeader()
+{
+  PackedPuzzleFormat::Header header = { true, 0x123456789ull, 0xABCDEF01ull, 0xCBF43926u };
+  char bytes[PackedPuzzleFormat::headerSize];
+  PackedPuzzleFormat::writeHeader(header, bytes);
+
+  PackedPuzzleFormat::Header read = { false, 0, 0, 0 };
+  CPPUNIT_ASSERT( PackedPuzzleFormat::readHeader(bytes, read) );
+  CPPUNIT_ASSERT( read.hasSolutions );
+  CPPUNIT_ASSERT_EQUAL( header.numberOfPuzzles, read.numberOfPuzzles );
+  CPPUNIT_ASSERT_EQUAL( header.indexOffset, read.indexOffset );
+  CPPUNIT_ASSERT_EQUAL( header.checksum, read.checksum );
+
+  header.hasSolutions = false;
+  PackedPuzzleFormat::writeHeader(header, bytes);
+  CPPUNIT_ASSERT( PackedPuzzleFormat::readHeader(bytes, read) );
+  CPPUNIT_ASSERT( ! read.hasSolutions );
+
+  bytes[0] = 'X';
+  CPPUNIT_ASSERT( ! PackedPuzzleFormat::readHeader(bytes, read) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleFormatTest::testChecksum()
+{
+  const char* check("123456789");
+
+  CPPUNIT_ASSERT_EQUAL( std::uint32_t(0), PackedPuzzleFormat::updateChecksum(0, check, 0) );
+  CPPUNIT_ASSERT_EQUAL( std::uint32_t(0xCBF43926u),
+    PackedPuzzleFormat::updateChecksum(0, check, 9) );
+  CPPUNIT_ASSERT_EQUAL( std::uint32_t(0xCBF43926u),
+    PackedPuzzleFormat::updateChecksum(PackedPuzzleFormat::updateChecksum(0, check, 4),
+      check + 4, 5) );
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,57 @@
+#ifndef __sudoku_packedpuzzleformattest_h__
+#define __sudoku_packedpuzzleformattest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for PackedPuzzleFormat.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/PackedPuzzleFormat.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PackedPuzzleFormatTest class for testing PackedPuzzleFormat.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PackedPuzzleFormatTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PackedPuzzleFormatTest);
+  CPPUNIT_TEST(testPackingPuzzles);
+  CPPUNIT_TEST(testPackingInvalidValues);
+  CPPUNIT_TEST(testUnpackingTruncatedPuzzle);
+  CPPUNIT_TEST(testPackingSolutions);
+  CPPUNIT_TEST(testWritingAndReadingHeader);
+  CPPUNIT_TEST(testChecksum);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    /// \test Test puzzles with an odd and even number of values, none and all, are packed into
+    /// the bitmap and half a byte per value, and unpacked the same.
+    void testPackingPuzzles();
+
+    /// \test Test values outside 0 to 9 cannot be packed.
+    void testPackingInvalidValues();
+
+    /// \test Test a puzzle is not unpacked if its values are cut off or a value is 0.
+    void testUnpackingTruncatedPuzzle();
+
+    /// \test Test a solution is packed into solutionSize bytes and unpacked the same.
+    void testPackingSolutions();
+
+    /// \test Test a header is read back as written, and one with the wrong magic is rejected.
+    void testWritingAndReadingHeader();
+
+    /// \test Test the checksum is the standard CRC-32 and can be built up in pieces.
+    void testChecksum();
+};
+
+} // End of namespace sudoku.
+
+#endif
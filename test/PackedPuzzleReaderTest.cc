@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for PackedPuzzleReader and PackedPuzzleWriter.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include "src/PackedPuzzleReader.h"
+#include "src/PackedPuzzleWriter.h"
+#include "PackedPuzzleReaderTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::PackedPuzzleReaderTest );
+
+namespace
+{
+
+// A solved board.
+const short testSolution[81] =
+{
+1, 8, 9, 6, 2, 4, 5, 7, 3,
+4, 3, 6, 9, 5, 7, 8, 2, 1,
+5, 2, 7, 8, 3, 1, 6, 9, 4,
+2, 9, 4, 3, 8, 5, 1, 6, 7,
+3, 5, 8, 1, 7, 6, 9, 4, 2,
+6, 7, 1, 2, 4, 9, 3, 5, 8,
+9, 4, 3, 7, 6, 8, 2, 1, 5,
+8, 6, 5, 4, 1, 2, 7, 3, 9,
+7, 1, 2, 5, 9, 3, 4, 8, 6
+};
+
+// The number of puzzles written by most tests, filling several blocks of the index.
+const std::uint64_t numberOfTestPuzzles(3 * sudoku::PackedPuzzleFormat::indexBlockSize + 17);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Makes a different puzzle for each number by clearing grid points of testSolution, so the
+/// records have different sizes.
+/// \param number The number of the puzzle.
+/// \param puzzle Filled with the puzzle.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void makePuzzle( std::uint64_t number, short (&puzzle)[81] )
+{
+  std::copy(testSolution, testSolution + 81, puzzle);
+  for ( std::uint64_t i(number % 7); i < 81; i += 1 + number % 5 )
+  {
+    puzzle[i] = 0;
+  }
+}
+
+} // End of anonymous namespace.
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testReadingPuzzles()
+{
+  writeFile(numberOfTestPuzzles, false);
+
+  PackedPuzzleReader subject(path_);
+  CPPUNIT_ASSERT_EQUAL( numberOfTestPuzzles, subject.getNumberOfPuzzles() );
+  CPPUNIT_ASSERT( ! subject.hasSolutions() );
+
+  short expected[81];
+  short values[81];
+
+  // Backwards and jumping about, as well as in order.
+  for ( std::uint64_t i(0); i < numberOfTestPuzzles; ++i )
+  {
+    for ( auto number : { i, numberOfTestPuzzles - 1 - i, i * 97 % numberOfTestPuzzles } )
+    {
+      makePuzzle(number, expected);
+      subject.readPuzzle(number, values);
+      CPPUNIT_ASSERT( std::equal(values, values + 81, expected) );
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testReadingPuzzlesAndSolutions()
+{
+  writeFile(numberOfTestPuzzles, true);
+
+  PackedPuzzleReader subject(path_);
+  CPPUNIT_ASSERT_EQUAL( numberOfTestPuzzles, subject.getNumberOfPuzzles() );
+  CPPUNIT_ASSERT( subject.hasSolutions() );
+
+  short expected[81];
+  short values[81];
+
+  for ( std::uint64_t i(0); i < numberOfTestPuzzles; ++i )
+  {
+    const std::uint64_t number(numberOfTestPuzzles - 1 - i);
+    makePuzzle(number, expected);
+    subject.readPuzzle(number, values);
+    CPPUNIT_ASSERT( std::equal(values, values + 81, expected) );
+    subject.readSolution(number, values);
+    CPPUNIT_ASSERT( std::equal(values, values + 81, testSolution) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testReadingEmptyFile()
+{
+  writeFile(0, true);
+
+  PackedPuzzleReader subject(path_);
+  short values[81];
+
+  CPPUNIT_ASSERT_EQUAL( std::uint64_t(0), subject.getNumberOfPuzzles() );
+  CPPUNIT_ASSERT( subject.hasSolutions() );
+  CPPUNIT_ASSERT_THROW( subject.readPuzzle(0, values), std::out_of_range );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testReadingBoard()
+{
+  short puzzle[81];
+  makePuzzle(3, puzzle); // A quarter of the grid points cleared, so one solution.
+  {
+    PackedPuzzleWriter writer(path_, false);
+    writer.write(SudokuBoard(puzzle));
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t(1), writer.getNumberOfPuzzles() );
+  }
+
+  PackedPuzzleReader subject(path_);
+  SudokuBoard board(subject.readBoard(0));
+  short values[81];
+
+  board.getValues(values);
+  CPPUNIT_ASSERT( std::equal(values, values + 81, puzzle) );
+
+  board.solveBoard();
+  board.getValues(values);
+  CPPUNIT_ASSERT( std::equal(values, values + 81, testSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testExceptionThrownIfPuzzleMissing()
+{
+  writeFile(numberOfTestPuzzles, false);
+
+  PackedPuzzleReader subject(path_);
+  short values[81];
+
+  CPPUNIT_ASSERT_THROW( subject.readPuzzle(numberOfTestPuzzles, values), std::out_of_range );
+  CPPUNIT_ASSERT_THROW( subject.readBoard(numberOfTestPuzzles), std::out_of_range );
+  CPPUNIT_ASSERT_THROW( subject.readSolution(0, values), std::logic_error );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testExceptionThrownIfFileCorrupt()
+{
+  writeFile(numberOfTestPuzzles, true);
+  {
+    std::fstream file(path_.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(PackedPuzzleFormat::headerSize + 100);
+    file.put('\x55');
+  }
+
+  CPPUNIT_ASSERT_THROW( PackedPuzzleReader(path_, true), std::runtime_error );
+
+  // Without the check the file opens.
+  PackedPuzzleReader unchecked(path_, false);
+  CPPUNIT_ASSERT_EQUAL( numberOfTestPuzzles, unchecked.getNumberOfPuzzles() );
+
+  // Cut off the last byte of the index.
+  std::ifstream file(path_.c_str(), std::ios::binary | std::ios::ate);
+  CPPUNIT_ASSERT_EQUAL( 0, truncate(path_.c_str(), static_cast<off_t>(file.tellg()) - 1) );
+  CPPUNIT_ASSERT_THROW( PackedPuzzleReader(path_, false), std::runtime_error );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testExceptionThrownIfNotPackedFile()
+{
+  {
+    std::ofstream file(path_.c_str(), std::ios::binary);
+    file << std::string(100, '.') << "\n";
+  }
+
+  CPPUNIT_ASSERT_THROW( PackedPuzzleReader(path_, true), std::runtime_error );
+  CPPUNIT_ASSERT_THROW( PackedPuzzleReader("/no/such/puzzles.sdkp"), std::runtime_error );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::testExceptionThrownIfWritingWrongRecord()
+{
+  short puzzle[81];
+  makePuzzle(0, puzzle);
+
+  PackedPuzzleWriter withSolutions(path_, true);
+  CPPUNIT_ASSERT_THROW( withSolutions.write(puzzle), std::logic_error );
+  CPPUNIT_ASSERT_THROW( withSolutions.write(puzzle, puzzle), std::invalid_argument );
+  withSolutions.write(puzzle, testSolution);
+  withSolutions.close();
+  CPPUNIT_ASSERT_THROW( withSolutions.write(puzzle, testSolution), std::logic_error );
+
+  PackedPuzzleWriter withoutSolutions(path_, false);
+  CPPUNIT_ASSERT_THROW( withoutSolutions.write(puzzle, testSolution), std::logic_error );
+  CPPUNIT_ASSERT_EQUAL( std::uint64_t(0), withoutSolutions.getNumberOfPuzzles() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::writeFile( std::uint64_t numberOfPuzzles, bool hasSolutions )
+{
+  PackedPuzzleWriter writer(path_, hasSolutions);
+  short puzzle[81];
+
+  for ( std::uint64_t number(0); number < numberOfPuzzles; ++number )
+  {
+    makePuzzle(number, puzzle);
+    if ( hasSolutions )
+    {
+      writer.write(puzzle, testSolution);
+    }
+    else
+    {
+      writer.write(puzzle);
+    }
+  }
+
+  writer.close();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::setUp()
+{
+  path_ = "/tmp/PackedPuzzleReaderTest." + std::to_string(getpid());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PackedPuzzleReaderTest::tearDown()
+{
+  (void)std::remove(path_.c_str());
+}
+
+} // End of namespace sudoku.
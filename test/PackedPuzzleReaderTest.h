@@ -0,0 +1,83 @@
+#ifndef __sudoku_packedpuzzlereadertest_h__
+#define __sudoku_packedpuzzlereadertest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for PackedPuzzleReader and PackedPuzzleWriter.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/PackedPuzzleReader.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PackedPuzzleReaderTest class for testing PackedPuzzleReader and PackedPuzzleWriter.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PackedPuzzleReaderTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PackedPuzzleReaderTest);
+  CPPUNIT_TEST(testReadingPuzzles);
+  CPPUNIT_TEST(testReadingPuzzlesAndSolutions);
+  CPPUNIT_TEST(testReadingEmptyFile);
+  CPPUNIT_TEST(testReadingBoard);
+  CPPUNIT_TEST(testExceptionThrownIfPuzzleMissing);
+  CPPUNIT_TEST(testExceptionThrownIfFileCorrupt);
+  CPPUNIT_TEST(testExceptionThrownIfNotPackedFile);
+  CPPUNIT_TEST(testExceptionThrownIfWritingWrongRecord);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    void tearDown();
+
+    /// \test Test puzzles filling several blocks of the index are read back in any order.
+    void testReadingPuzzles();
+
+    /// \test Test puzzles and their solutions are read back.
+    void testReadingPuzzlesAndSolutions();
+
+    /// \test Test a file with no puzzles.
+    void testReadingEmptyFile();
+
+    /// \test Test a puzzle is read into a board that can be solved.
+    void testReadingBoard();
+
+    /// \test Test reading a puzzle past the end, or a solution from a file without them.
+    void testExceptionThrownIfPuzzleMissing();
+
+    /// \test Test a changed byte fails the checksum, and a cut off file fails the index check.
+    void testExceptionThrownIfFileCorrupt();
+
+    /// \test Test opening a text file, or one that does not exist.
+    void testExceptionThrownIfNotPackedFile();
+
+    /// \test Test the writer rejects records that do not match the file, or come after close.
+    void testExceptionThrownIfWritingWrongRecord();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    std::string path_; // A file to write for the test, removed afterwards.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    // Writes numberOfPuzzles puzzles to path_, with solutions if hasSolutions.
+    void writeFile( std::uint64_t numberOfPuzzles, bool hasSolutions );
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for PuzzleFile.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include "src/PuzzleFile.h"
+#include "PuzzleFileTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::PuzzleFileTest );
+
+// The test board written with dots, and its values.
+const std::string testBoard(sudoku::testboards::toText(sudoku::testboards::testBoard));
+const short (&testBoardValues)[81](sudoku::testboards::testBoard);
+
+// The Al Escargot written with zeroes.
+const std::string alEscargot(sudoku::testboards::toText(sudoku::testboards::alEscargot, '0'));
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::testDecodingDigitsAndDots()
+{
+  short values[81];
+
+  CPPUNIT_ASSERT( PuzzleFile::decode(testBoard.data(), values) );
+  CPPUNIT_ASSERT( std::equal(values, values + 81, testBoardValues) );
+
+  CPPUNIT_ASSERT( PuzzleFile::decode(alEscargot.data(), values) );
+  for ( short i(0); i < 81; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( static_cast<short>(alEscargot[i] - '0'), values[i] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::testDecodingRejectsOtherCharacters()
+{
+  // Each side of the digits, and characters that wrap round when '0' is taken away.
+  const std::string others("/:- x\t\x80\xff");
+  short values[81];
+
+  for ( short i(0); i < 81; ++i )
+  {
+    for ( auto other : others )
+    {
+      std::string puzzle(testBoard);
+      puzzle[i] = other;
+      CPPUNIT_ASSERT( ! PuzzleFile::decode(puzzle.data(), values) );
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::testReadingLines()
+{
+  writeFile(testBoard + "\n" + alEscargot + "\r\n" + "short\n" + "\n" + testBoard);
+
+  PuzzleFile subject(path_);
+  const char* line;
+  std::size_t length;
+
+  CPPUNIT_ASSERT( subject.nextLine(line, length) );
+  CPPUNIT_ASSERT_EQUAL( testBoard, std::string(line, length) );
+  CPPUNIT_ASSERT( subject.nextLine(line, length) );
+  CPPUNIT_ASSERT_EQUAL( alEscargot, std::string(line, length) );
+  CPPUNIT_ASSERT( subject.nextLine(line, length) );
+  CPPUNIT_ASSERT_EQUAL( std::string("short"), std::string(line, length) );
+  CPPUNIT_ASSERT( subject.nextLine(line, length) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), length );
+
+  // The last line has no '\n'.
+  CPPUNIT_ASSERT( subject.nextLine(line, length) );
+  CPPUNIT_ASSERT_EQUAL( testBoard, std::string(line, length) );
+  CPPUNIT_ASSERT( ! subject.nextLine(line, length) );
+  CPPUNIT_ASSERT( ! subject.nextLine(line, length) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::testReadingEmptyFile()
+{
+  writeFile("");
+
+  PuzzleFile subject(path_);
+  const char* line;
+  std::size_t length;
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), subject.getSize() );
+  CPPUNIT_ASSERT( ! subject.nextLine(line, length) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::testExceptionThrownIfFileMissing()
+{
+  CPPUNIT_ASSERT_THROW( PuzzleFile("/no/such/puzzles.txt"), std::runtime_error );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::writeFile( const std::string& contents )
+{
+  std::ofstream file(path_.c_str(), std::ios::binary);
+  file << contents;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::setUp()
+{
+  path_ = "/tmp/PuzzleFileTest." + std::to_string(getpid());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void PuzzleFileTest::tearDown()
+{
+  (void)std::remove(path_.c_str());
+}
+
+} // End of namespace sudoku.
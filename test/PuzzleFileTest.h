@@ -0,0 +1,69 @@
+#ifndef __sudoku_puzzlefiletest_h__
+#define __sudoku_puzzlefiletest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for PuzzleFile.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/PuzzleFile.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief PuzzleFileTest class for testing PuzzleFile.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class PuzzleFileTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(PuzzleFileTest);
+  CPPUNIT_TEST(testDecodingDigitsAndDots);
+  CPPUNIT_TEST(testDecodingRejectsOtherCharacters);
+  CPPUNIT_TEST(testReadingLines);
+  CPPUNIT_TEST(testReadingEmptyFile);
+  CPPUNIT_TEST(testExceptionThrownIfFileMissing);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    void tearDown();
+
+    /// \test Test decoding puzzles written with dots and with zeroes.
+    void testDecodingDigitsAndDots();
+
+    /// \test Test a character other than a digit or dot anywhere in a puzzle is rejected.
+    void testDecodingRejectsOtherCharacters();
+
+    /// \test Test the lines of a file are given in order without their endings.
+    void testReadingLines();
+
+    /// \test Test an empty file has no lines.
+    void testReadingEmptyFile();
+
+    /// \test Test opening a file that does not exist.
+    void testExceptionThrownIfFileMissing();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    std::string path_; // A file to write for the test, removed afterwards.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    void writeFile( const std::string& contents ); // Writes contents to path_.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for SolutionCache.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "src/SolutionCache.h"
+#include "src/SudokuCanonicalizer.h"
+#include "SolutionCacheTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SolutionCacheTest );
+
+namespace
+{
+
+using sudoku::testboards::alEscargot;
+using sudoku::testboards::testBoard;
+using sudoku::testboards::testBoardSolution;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Makes a transform that swaps the rows and columns, reverses the bands and the columns
+/// in each stack, and shifts the values along by shift.
+/// \param shift The amount the values are shifted, 0 to 8.
+/// \return The transform.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+sudoku::SudokuTransform makeTransform( short shift )
+{
+  sudoku::SudokuTransform transform(sudoku::SudokuTransform::identity());
+
+  transform.transpose = true;
+  for ( short i(0); i < 9; ++i )
+  {
+    transform.rows[i] = ( 2 - i / 3 ) * 3 + i % 3;
+    transform.columns[i] = i / 3 * 3 + 2 - i % 3;
+    transform.values[i + 1] = ( i + shift ) % 9 + 1;
+  }
+
+  return transform;
+}
+
+} // End of anonymous namespace.
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testSolvingPuzzleTwice()
+{
+  SolutionCache subject(1 << 20);
+  short solution[81];
+
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(testBoard, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, testBoardSolution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getMisses() );
+
+  // A puzzle like no other is kept as it is, without its canonical form.
+  CPPUNIT_ASSERT_EQUAL( std::size_t(1), subject.getSize() );
+
+  std::fill(solution, solution + 81, 0);
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(SudokuBoard(testBoard), solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, testBoardSolution) );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getMisses() );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(1), subject.getSize() );
+
+  subject.clear();
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getMisses() );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), subject.getSize() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testSolvingTransformedPuzzle()
+{
+  SolutionCache subject(1 << 20);
+  short solution[81];
+  subject.solve(testBoard, solution);
+
+  for ( short shift(1); shift < 4; ++shift )
+  {
+    const SudokuTransform transform(makeTransform(shift));
+    short puzzle[81];
+    short expected[81];
+    transform.apply(testBoard, puzzle);
+    transform.apply(testBoardSolution, expected);
+
+    CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(puzzle, solution) );
+    CPPUNIT_ASSERT( std::equal(solution, solution + 81, expected) );
+    CPPUNIT_ASSERT_EQUAL( static_cast<unsigned long>(shift), subject.getHits() );
+    CPPUNIT_ASSERT_EQUAL( 1ul, subject.getMisses() );
+  }
+
+  // The first transform adds the canonical form, and each is kept as well.
+  CPPUNIT_ASSERT_EQUAL( std::size_t(5), subject.getSize() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testNumberOfSolutions()
+{
+  SolutionCache subject(1 << 20);
+  short solution[81];
+
+  const short empty[81] = { 0 };
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.solve(empty, solution) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.solve(empty, solution) );
+
+  short noSolution[81];
+  std::copy(testBoard, testBoard + 81, noSolution);
+  noSolution[0] = 3;
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.solve(noSolution, solution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.solve(noSolution, solution) );
+
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getMisses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testLeastRecentlyUsedDropped()
+{
+  SolutionCache subject(4 * SolutionCache::getEntryMemory());
+  short solution[81];
+  CPPUNIT_ASSERT_EQUAL( std::size_t(4), subject.getCapacity() );
+
+  short transformed[81];
+  makeTransform(1).apply(testBoard, transformed);
+
+  // Puzzles like no other are kept as they are.
+  subject.solve(testBoard, solution);
+  subject.solve(alEscargot, solution);
+  CPPUNIT_ASSERT_EQUAL( std::size_t(2), subject.getSize() );
+
+  // A transform of the test board adds itself and their canonical form.
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(transformed, solution) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(4), subject.getSize() );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getHits() );
+
+  // A third puzzle, which has no solution, drops the test board, used least recently.
+  short third[81];
+  makeTransform(0).apply(alEscargot, third);
+  std::copy(testBoardSolution, testBoardSolution + 9, third);
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.solve(third, solution) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(4), subject.getSize() );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject.getMisses() );
+
+  // The test board is still found through the canonical form, and drops the Al Escargot.
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(testBoard, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, testBoardSolution) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getHits() );
+  subject.solve(alEscargot, solution);
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 4ul, subject.getMisses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testPuzzlesWithSameFingerprint()
+{
+  SolutionCache subject(1 << 20);
+  short solution[81];
+
+  // Swapping two values in a row keeps the numbers of values in every row and column and of each
+  // value, but the board has no solution.
+  short changed[81];
+  std::copy(testBoardSolution, testBoardSolution + 81, changed);
+  std::swap(changed[0], changed[1]);
+
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(testBoardSolution, solution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.solve(changed, solution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getMisses() );
+
+  // Both boards, and both canonical forms.
+  CPPUNIT_ASSERT_EQUAL( std::size_t(4), subject.getSize() );
+
+  short transformed[81];
+  makeTransform(2).apply(testBoardSolution, transformed);
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(transformed, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, transformed) );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject.getHits() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testMemoryCapped()
+{
+  CPPUNIT_ASSERT( SolutionCache::getEntryMemory() >= 2 * 48 );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(1000),
+    SolutionCache(1000 * SolutionCache::getEntryMemory() + 1).getCapacity() );
+
+  SolutionCache subject(0);
+  short solution[81];
+  for ( short i(0); i < 2; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( 1ul, subject.solve(testBoard, solution) );
+    CPPUNIT_ASSERT( std::equal(solution, solution + 81, testBoardSolution) );
+  }
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), subject.getSize() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getHits() );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject.getMisses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testSharingBetweenThreads()
+{
+  SolutionCache subject(1 << 20);
+  const short numberOfThreads(4);
+  const short callsPerThread(6);
+  std::atomic<int> failures(0);
+  std::vector<std::thread> threads;
+
+  for ( short thread(0); thread < numberOfThreads; ++thread )
+  {
+    threads.emplace_back([&subject, &failures, thread]
+    {
+      for ( short call(0); call < callsPerThread; ++call )
+      {
+        const SudokuTransform transform(makeTransform(( thread + call ) % 3));
+        short puzzle[81];
+        short expected[81];
+        short solution[81];
+        transform.apply(testBoard, puzzle);
+        transform.apply(testBoardSolution, expected);
+        if ( subject.solve(puzzle, solution) != 1 ||
+             ! std::equal(solution, solution + 81, expected) )
+        {
+          ++failures;
+        }
+      }
+    });
+  }
+  for ( auto &thread : threads )
+  {
+    thread.join();
+  }
+
+  CPPUNIT_ASSERT_EQUAL( 0, failures.load() );
+  CPPUNIT_ASSERT_EQUAL( static_cast<unsigned long>(numberOfThreads * callsPerThread),
+    subject.getHits() + subject.getMisses() );
+  // The three transforms, and their canonical form unless every transform was first solved at
+  // the same time, each as it was.
+  CPPUNIT_ASSERT( subject.getSize() == 3 || subject.getSize() == 4 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SolutionCacheTest::testExceptionThrownIfValueInvalid()
+{
+  SolutionCache subject(1 << 20);
+  short puzzle[81];
+  short solution[81];
+  std::copy(testBoard, testBoard + 81, puzzle);
+
+  puzzle[80] = 10;
+  CPPUNIT_ASSERT_THROW( subject.solve(puzzle, solution), std::invalid_argument );
+  puzzle[80] = -1;
+  CPPUNIT_ASSERT_THROW( subject.solve(puzzle, solution), std::invalid_argument );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject.getMisses() );
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,66 @@
+#ifndef __sudoku_solutioncachetest_h__
+#define __sudoku_solutioncachetest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for SolutionCache.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/SolutionCache.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SolutionCacheTest class for testing SolutionCache.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SolutionCacheTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SolutionCacheTest);
+  CPPUNIT_TEST(testSolvingPuzzleTwice);
+  CPPUNIT_TEST(testSolvingTransformedPuzzle);
+  CPPUNIT_TEST(testNumberOfSolutions);
+  CPPUNIT_TEST(testLeastRecentlyUsedDropped);
+  CPPUNIT_TEST(testPuzzlesWithSameFingerprint);
+  CPPUNIT_TEST(testMemoryCapped);
+  CPPUNIT_TEST(testSharingBetweenThreads);
+  CPPUNIT_TEST(testExceptionThrownIfValueInvalid);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    /// \test Test a puzzle is solved and counted as a miss, then as a hit.
+    void testSolvingPuzzleTwice();
+
+    /// \test Test transforms of a solved puzzle are hits, with their own solutions.
+    void testSolvingTransformedPuzzle();
+
+    /// \test Test puzzles with no solution and with more than one are cached too.
+    void testNumberOfSolutions();
+
+    /// \test Test the entries used least recently are dropped when the cache is full.
+    void testLeastRecentlyUsedDropped();
+
+    /// \test Test puzzles with the same fingerprint that are not transforms of each other are
+    /// solved apart, and their canonical forms kept.
+    void testPuzzlesWithSameFingerprint();
+
+    /// \test Test the number of entries follows the memory given, and with no memory nothing is
+    /// kept but puzzles are still solved.
+    void testMemoryCapped();
+
+    /// \test Test threads sharing a cache get the right solutions and every call is counted.
+    void testSharingBetweenThreads();
+
+    /// \test Test a value outside 0 to 9 is rejected.
+    void testExceptionThrownIfValueInvalid();
+};
+
+} // End of namespace sudoku.
+
+#endif
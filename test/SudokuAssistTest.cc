@@ -3,16 +3,93 @@
 /// \author anon
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
 #include <boost/shared_ptr.hpp>
+#include <stdexcept>
+#include <string>
 
+#include "src/PuzzleFile.h"
 #include "src/SudokuAssist.h"
+#include "src/SudokuBitBoard.h"
 #include "SudokuAssistTest.h"
+#include "TestBoards.h"
 
 CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SudokuAssistTest );
 
 namespace sudoku
 {
 
+namespace
+{
+
+// A board that only needs hidden and naked singles.
+const char* const singlesBoard =
+  "..3...2.7....3...8.9..8..1.....1..4.....28.....14......6....52.1.2..4..68....9..4";
+
+// Al Escargot, which needs more than the techniques.
+const std::string alEscargot(testboards::toText(testboards::alEscargot));
+
+// A board and the hardest technique it needs.
+struct RatedBoard
+{
+  const char* board;
+  Technique technique;
+};
+
+const RatedBoard ratedBoards[] = {
+  { ".965..3......3..25.8...26....4.8.26....7.....61.....591.....4..4.2....73.5.......",
+    Technique::NakedSingle },
+  { "..42...5......8.3.986..3...6......73..2.6..1.....17..4.3...........5...1..5..1..6",
+    Technique::LockedCandidates },
+  { "..1.3...59.......8.32...7.6.....6.7..89.2....3......4....8.......43..9.....175...",
+    Technique::NakedSubset },
+  { ".8....19..........42.9....7....1.87.7.....3.2....35.....7.9...4...3..28....4.1...",
+    Technique::HiddenSubset },
+  { "....29..8....1....9...5...21..............68...8.9645.3.6..5...5.....1.3..9..8...",
+    Technique::XWing },
+  { ".5.....3.2......1...13..4........5...2.1.9.8..79.4......3..57...1...2....6..7...4",
+    Technique::Swordfish },
+  { "..845...3.....6.5.6..8..27.4..7.......1..5........156.96..73.........1..3.2......",
+    Technique::XYWing },
+  { ".95....8....5..3.11..3...4..2.9..........1..34.7.....25..12......4..8.2.......5.7",
+    Technique::SimpleChain }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Decodes a board.
+/// \param board The board, 81 digits or dots.
+/// \param values Filled with the values.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void decode( const char* board, short (&values)[SudokuTables::numberOfGridPoints] )
+{
+  CPPUNIT_ASSERT( PuzzleFile::decode(board, values) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks the values found agree with the solution of a board.
+/// \param values The board.
+/// \param result The values found, 0 where none was found.
+/// \return The number of values found that are not in the board.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+short checkResult( const short (&values)[SudokuTables::numberOfGridPoints],
+  const short (&result)[SudokuTables::numberOfGridPoints] )
+{
+  SudokuBitBoard solver;
+  short solution[SudokuTables::numberOfGridPoints];
+  CPPUNIT_ASSERT( solver.solve(values, solution) );
+
+  short found(0);
+  for ( short i(0); i < SudokuTables::numberOfGridPoints; ++i )
+  {
+    CPPUNIT_ASSERT( values[i] == 0 || result[i] == values[i] );
+    CPPUNIT_ASSERT( result[i] == 0 || result[i] == solution[i] );
+    found += ( values[i] == 0 && result[i] != 0 ) ? 1 : 0;
+  }
+  return found;
+}
+
+} // End of anonymous namespace.
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 boost::shared_ptr<SudokuAssist> SudokuAssistTest::createSubject()
 {
@@ -26,4 +103,204 @@ void SudokuAssistTest::setUp()
   subject_ = createSubject();
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testSolvingWithSingles()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short result[SudokuTables::numberOfGridPoints];
+  decode(singlesBoard, values);
+
+  CPPUNIT_ASSERT( subject_->solve(values, result) );
+
+  const short missing(static_cast<short>(std::count(values, values + 81, 0)));
+  CPPUNIT_ASSERT_EQUAL( missing, checkResult(values, result) );
+  CPPUNIT_ASSERT( subject_->getHardestTechnique() == Technique::HiddenSingle );
+  CPPUNIT_ASSERT_EQUAL( static_cast<unsigned int>(missing),
+    subject_->getUses(Technique::HiddenSingle) + subject_->getUses(Technique::NakedSingle) );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject_->getUses(Technique::LockedCandidates) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testRatingEachTechnique()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short result[SudokuTables::numberOfGridPoints];
+
+  for ( const auto& rated : ratedBoards )
+  {
+    decode(rated.board, values);
+
+    CPPUNIT_ASSERT( subject_->rate(values) == rated.technique );
+    CPPUNIT_ASSERT( subject_->getUses(rated.technique) > 0 );
+
+    CPPUNIT_ASSERT( subject_->solve(values, result) );
+    CPPUNIT_ASSERT( subject_->getHardestTechnique() == rated.technique );
+    CPPUNIT_ASSERT_EQUAL( static_cast<short>(std::count(values, values + 81, 0)),
+      checkResult(values, result) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testGuessingIfTechniquesNotEnough()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short result[SudokuTables::numberOfGridPoints];
+  decode(alEscargot.c_str(), values);
+
+  CPPUNIT_ASSERT( ! subject_->solve(values, result) );
+  CPPUNIT_ASSERT( subject_->getHardestTechnique() == Technique::Guessing );
+  CPPUNIT_ASSERT( checkResult(values, result) < std::count(values, values + 81, 0) );
+  CPPUNIT_ASSERT( subject_->rate(values) == Technique::Guessing );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testSolvedBoardNeedsNothing()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short solution[SudokuTables::numberOfGridPoints];
+  decode(singlesBoard, values);
+  CPPUNIT_ASSERT( subject_->solve(values, solution) );
+
+  CPPUNIT_ASSERT( subject_->rate(solution) == Technique::None );
+  for ( short i(0); i < SudokuAssist::numberOfTechniques; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( 0u, subject_->getUses(static_cast<Technique>(i)) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testInvalidBoards()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short result[SudokuTables::numberOfGridPoints];
+  decode(singlesBoard, values);
+
+  // The 3 in the first row given again at its end.
+  values[8] = 3;
+  CPPUNIT_ASSERT( ! subject_->solve(values, result) );
+  CPPUNIT_ASSERT( subject_->rate(values) == Technique::Guessing );
+
+  values[8] = 10;
+  CPPUNIT_ASSERT_THROW( subject_->rate(values), std::invalid_argument );
+  values[8] = -1;
+  CPPUNIT_ASSERT_THROW( subject_->solve(values, result), std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testTechniqueNames()
+{
+  CPPUNIT_ASSERT_EQUAL( std::string("Hidden single"),
+    std::string(SudokuAssist::getTechniqueName(Technique::HiddenSingle)) );
+  CPPUNIT_ASSERT_EQUAL( std::string("X-Wing"),
+    std::string(SudokuAssist::getTechniqueName(Technique::XWing)) );
+  CPPUNIT_ASSERT_EQUAL( std::string("Guessing"),
+    std::string(SudokuAssist::getTechniqueName(Technique::Guessing)) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testHintsSolveBoard()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short solution[SudokuTables::numberOfGridPoints];
+  short current[SudokuTables::numberOfGridPoints];
+  SudokuBitBoard solver;
+  SudokuHint hint;
+
+  for ( const auto& rated : ratedBoards )
+  {
+    decode(rated.board, values);
+    CPPUNIT_ASSERT( solver.solve(values, solution) );
+    CPPUNIT_ASSERT( subject_->start(values) );
+
+    Technique hardest(Technique::None);
+    while ( subject_->nextHint(hint) )
+    {
+      CPPUNIT_ASSERT_EQUAL( solution[hint.x * 9 + hint.y], hint.value );
+      CPPUNIT_ASSERT( subject_->place(hint.x, hint.y, hint.value) );
+      hardest = std::max(hardest, hint.technique);
+    }
+
+    subject_->getValues(current);
+    CPPUNIT_ASSERT( std::equal(solution, solution + 81, current) );
+    CPPUNIT_ASSERT( hardest == rated.technique );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testPlaceAndErase()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  short solution[SudokuTables::numberOfGridPoints];
+  short current[SudokuTables::numberOfGridPoints];
+  decode(ratedBoards[6].board, values);
+  CPPUNIT_ASSERT( SudokuBitBoard().solve(values, solution) );
+  CPPUNIT_ASSERT( subject_->start(values) );
+
+  SudokuHint first;
+  CPPUNIT_ASSERT( subject_->nextHint(first) );
+
+  // Fill in the last row, then take it out again.
+  for ( short y(0); y < 9; ++y )
+  {
+    CPPUNIT_ASSERT_EQUAL( values[72 + y] == 0, subject_->place(8, y, solution[72 + y]) );
+  }
+  for ( short y(0); y < 9; ++y )
+  {
+    CPPUNIT_ASSERT_EQUAL( values[72 + y] == 0, subject_->erase(8, y) );
+  }
+
+  SudokuHint hint;
+  CPPUNIT_ASSERT( subject_->nextHint(hint) );
+  CPPUNIT_ASSERT_EQUAL( first.x, hint.x );
+  CPPUNIT_ASSERT_EQUAL( first.y, hint.y );
+  CPPUNIT_ASSERT_EQUAL( first.value, hint.value );
+  CPPUNIT_ASSERT_EQUAL( first.explanation, hint.explanation );
+  subject_->getValues(current);
+  CPPUNIT_ASSERT( std::equal(values, values + 81, current) );
+
+  // The first row has 8 at its third grid point.
+  CPPUNIT_ASSERT( ! subject_->place(0, 0, 8) );
+  CPPUNIT_ASSERT( ! subject_->place(0, 2, solution[2]) );
+  CPPUNIT_ASSERT( ! subject_->erase(0, 2) );
+  CPPUNIT_ASSERT( ! subject_->erase(0, 0) );
+  CPPUNIT_ASSERT_THROW( subject_->place(9, 0, 1), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( subject_->place(0, 0, 0), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( subject_->erase(0, -1), std::invalid_argument );
+
+  // A wrong value leaves no hint until it is erased.
+  CPPUNIT_ASSERT( subject_->place(0, 0, 7) );
+  CPPUNIT_ASSERT( ! subject_->nextHint(hint) );
+  CPPUNIT_ASSERT( subject_->erase(0, 0) );
+  CPPUNIT_ASSERT( subject_->nextHint(hint) );
+  CPPUNIT_ASSERT_EQUAL( first.explanation, hint.explanation );
+
+  values[8] = 8;
+  CPPUNIT_ASSERT( ! subject_->start(values) );
+  subject_->getValues(current);
+  CPPUNIT_ASSERT_EQUAL( 81l, std::count(current, current + 81, 0) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuAssistTest::testHintExplanation()
+{
+  short values[SudokuTables::numberOfGridPoints];
+  SudokuHint hint;
+  decode(singlesBoard, values);
+  CPPUNIT_ASSERT( subject_->start(values) );
+
+  CPPUNIT_ASSERT( subject_->nextHint(hint) );
+  CPPUNIT_ASSERT( hint.technique == Technique::HiddenSingle );
+  CPPUNIT_ASSERT_EQUAL( std::string("In row 1, 8 can only go at r1c2."), hint.explanation );
+
+  decode(alEscargot.c_str(), values);
+  CPPUNIT_ASSERT( subject_->start(values) );
+  while ( subject_->nextHint(hint) )
+  {
+    CPPUNIT_ASSERT( subject_->place(hint.x, hint.y, hint.value) );
+  }
+  short current[SudokuTables::numberOfGridPoints];
+  subject_->getValues(current);
+  CPPUNIT_ASSERT( std::count(current, current + 81, 0) > 0 );
+}
+
 } // End of namespace sudoku.
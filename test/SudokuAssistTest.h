@@ -2,7 +2,7 @@
 #define __sudoku_sudokuassisttest_h__
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-/// \brief Declaration of tests for SudokuGridPoint.
+/// \brief Declaration of tests for SudokuAssist.
 /// \author anon
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -22,6 +22,15 @@ namespace sudoku
 class SudokuAssistTest : public CppUnit::TestFixture
 {
   CPPUNIT_TEST_SUITE(SudokuAssistTest);
+  CPPUNIT_TEST(testSolvingWithSingles);
+  CPPUNIT_TEST(testRatingEachTechnique);
+  CPPUNIT_TEST(testGuessingIfTechniquesNotEnough);
+  CPPUNIT_TEST(testSolvedBoardNeedsNothing);
+  CPPUNIT_TEST(testInvalidBoards);
+  CPPUNIT_TEST(testTechniqueNames);
+  CPPUNIT_TEST(testHintsSolveBoard);
+  CPPUNIT_TEST(testPlaceAndErase);
+  CPPUNIT_TEST(testHintExplanation);
   CPPUNIT_TEST_SUITE_END();
   
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -31,6 +40,33 @@ class SudokuAssistTest : public CppUnit::TestFixture
     void setUp();
     //void tearDown();
 
+    // \test Test a board that only needs singles is solved, with a single for each missing value.
+    void testSolvingWithSingles();
+
+    // \test Test boards that need each technique are rated by it and solved correctly.
+    void testRatingEachTechnique();
+
+    // \test Test a board the techniques cannot solve is rated Guessing, and partly solved.
+    void testGuessingIfTechniquesNotEnough();
+
+    // \test Test a board that is already solved is rated None.
+    void testSolvedBoardNeedsNothing();
+
+    // \test Test boards with a value twice in a unit, or values out of range.
+    void testInvalidBoards();
+
+    // \test Test the names of the techniques.
+    void testTechniqueNames();
+
+    // \test Test following the hints of a session solves boards that need each technique.
+    void testHintsSolveBoard();
+
+    // \test Test placing and erasing values, and that erasing a value undoes placing it.
+    void testPlaceAndErase();
+
+    // \test Test the explanation of a hint, and that a board needing a guess runs out of hints.
+    void testHintExplanation();
+
   //////////////////////////////////////////////////////////////////////////////////////////////////
   /// Private types and variables.
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for SudokuBitBoard.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <boost/shared_ptr.hpp>
+
+#include "src/SudokuBitBoard.h"
+#include "SudokuBitBoardTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SudokuBitBoardTest );
+
+namespace sudoku
+{
+
+using testboards::alEscargot;
+using testboards::alEscargotSolution;
+using testboards::checkSolution;
+using testboards::nonSolvableTestBoard;
+using testboards::testBoard;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testSolvingGoodBoard()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(testBoard, solution) );
+  CPPUNIT_ASSERT( checkSolution(testBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testSolvingAlEscargot()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, alEscargotSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testSolvingZeroesBoard()
+{
+  const short zeroesBoard[81] = { 0 };
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(zeroesBoard, solution) );
+  CPPUNIT_ASSERT( checkSolution(zeroesBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testClashingValuesNotSolvable()
+{
+  short board[81];
+  short solution[81];
+
+  std::copy(testBoard, testBoard + 81, board);
+  // 3 is already at (0,8).
+  board[0] = 3;
+
+  CPPUNIT_ASSERT( ! subject_->solve(board, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testBoardValidButNotSolvable()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( ! subject_->solve(nonSolvableTestBoard, solution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testReusedAfterEachSolve()
+{
+  short board[81];
+  short first[81];
+  short second[81];
+
+  std::copy(testBoard, testBoard + 81, board);
+  board[0] = 3;
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, first) );
+  CPPUNIT_ASSERT( ! subject_->solve(board, second) );
+  CPPUNIT_ASSERT( ! subject_->solve(nonSolvableTestBoard, second) );
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, second) );
+  CPPUNIT_ASSERT( std::equal(first, first + 81, second) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testForcedValuesSolveWithoutGuessing()
+{
+  short solution[81];
+
+  CPPUNIT_ASSERT( subject_->solve(testBoard, solution) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getGuesses() );
+
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  CPPUNIT_ASSERT( subject_->getGuesses() > 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::testCountSolutions()
+{
+  const short zeroesBoard[81] = { 0 };
+  short board[81];
+  short solution[81];
+
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(testBoard, 2) );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(alEscargot, 100) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->countSolutions(nonSolvableTestBoard, 2) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->countSolutions(testBoard, 0) );
+  CPPUNIT_ASSERT_EQUAL( 1000ul, subject_->countSolutions(zeroesBoard, 1000) );
+
+  // Without the 5 at (8,3) the test board has two solutions, and without the 3 at (1,1)
+  // instead it has three.
+  std::copy(testBoard, testBoard + 81, board);
+  board[75] = 0;
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject_->countSolutions(board, 100) );
+  board[75] = 5;
+  board[10] = 0;
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject_->countSolutions(board, 100) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject_->countSolutions(board, 2) );
+
+  // Solving still works after counting.
+  CPPUNIT_ASSERT( subject_->solve(alEscargot, solution) );
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, alEscargotSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+boost::shared_ptr<SudokuBitBoard> SudokuBitBoardTest::createSubject()
+{
+  boost::shared_ptr<SudokuBitBoard> subject(new SudokuBitBoard());
+  return subject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBitBoardTest::setUp()
+{
+  subject_ = createSubject();
+}
+
+} // End of namespace sudoku.
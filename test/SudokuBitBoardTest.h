@@ -0,0 +1,80 @@
+#ifndef __sudoku_sudokubitboardtest_h__
+#define __sudoku_sudokubitboardtest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for SudokuBitBoard.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/shared_ptr.hpp>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/SudokuBitBoard.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuBitBoardTest class for testing SudokuBitBoard.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuBitBoardTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SudokuBitBoardTest);
+  CPPUNIT_TEST(testSolvingGoodBoard);
+  CPPUNIT_TEST(testSolvingAlEscargot);
+  CPPUNIT_TEST(testSolvingZeroesBoard);
+  CPPUNIT_TEST(testClashingValuesNotSolvable);
+  CPPUNIT_TEST(testBoardValidButNotSolvable);
+  CPPUNIT_TEST(testReusedAfterEachSolve);
+  CPPUNIT_TEST(testForcedValuesSolveWithoutGuessing);
+  CPPUNIT_TEST(testCountSolutions);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    //void tearDown();
+
+    /// \test Test solving a good board.
+    void testSolvingGoodBoard();
+
+    /// \test Test solving the Al Escargot.
+    void testSolvingAlEscargot();
+
+    /// \test Test solving a board with no values.
+    void testSolvingZeroesBoard();
+
+    /// \test Test a board with the same value twice in a row has no solution.
+    void testClashingValuesNotSolvable();
+
+    /// \test Test a board that is valid but has no solution.
+    void testBoardValidButNotSolvable();
+
+    /// \test Test that the same object gives the same results when used again.
+    void testReusedAfterEachSolve();
+
+    /// \test Test a board solved by naked and hidden singles needs no guesses.
+    void testForcedValuesSolveWithoutGuessing();
+
+    /// \test Test counting the solutions of boards with none, one and several solutions.
+    void testCountSolutions();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<SudokuBitBoard> subject_; // subject used for testing.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<SudokuBitBoard> createSubject(); // Method used to create subject.
+};
+
+} // End of namespace sudoku.
+
+#endif
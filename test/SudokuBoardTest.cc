@@ -4,6 +4,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
@@ -173,6 +177,50 @@ bool checkBoardValuesAllSet( const short (&sudokuArray)[9][9] )
   return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks every row, column and box of a board has each value once.
+/// \param board The board.
+/// \return true if the board is solved, false otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template<short BoxSize>
+bool isBoardSolved( const BasicSudokuBoard<BoxSize>& board )
+{
+  typedef BasicSudokuTables<BoxSize> Tables;
+  const std::vector<BasicSudokuGridPoint<BoxSize> > gridPoints(board.getSudokuBoard());
+
+  for ( short unit(0); unit < Tables::numberOfUnits; ++unit )
+  {
+    ValueMask values(0);
+    for ( short i(0); i < Tables::boardSize; ++i )
+    {
+      const short value(gridPoints[Tables::getUnit(unit)[i]].getValue());
+      if ( value < 1 || value > Tables::boardSize )
+      {
+        return false;
+      }
+      values |= valueToMask(value);
+    }
+    if ( values != allValuesMask(Tables::boardSize) )
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks two boards have the same values and possible values at every grid point.
+/// \param lhs The first board.
+/// \param rhs The second board.
+/// \return true if the boards are the same, false otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool boardsEqual( const std::vector<SudokuGridPoint>& lhs, const std::vector<SudokuGridPoint>& rhs )
+{
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+    []( const SudokuGridPoint& l, const SudokuGridPoint& r ) { return l.shallowEquals(r); });
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SudokuBoardTest::testExceptionThrownIfValueLessThanZero()
 {
@@ -350,24 +398,927 @@ void SudokuBoardTest::testBoardValidButNotSolvable()
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
-void SudokuBoardTest::testBoardOrdered()
+void SudokuBoardTest::testBoardStoredRowByRow()
 {
-  // Default board is solvable.
+  bool result(true);
+
+  for ( int solved(0); solved < 2; ++solved )
+  {
+    // Default board is solvable.
+    if ( solved )
+    {
+      subject_->solveBoard();
+    }
+
+    std::vector<SudokuGridPoint> sudokuBoard( subject_->getSudokuBoard() );
+
+    for ( std::vector<SudokuGridPoint>::size_type i(0); i < sudokuBoard.size(); ++i )
+    {
+      if ( sudokuBoard.at(i).getX() != static_cast<short>(i / 9) ||
+           sudokuBoard.at(i).getY() != static_cast<short>(i % 9) )
+      {
+        result = false;
+      }
+    }
+  }
+
+  CPPUNIT_ASSERT( result );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testBoardRestoredIfNotSolvable()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  const std::vector<SudokuGridPoint> initialBoard(subject->getSudokuBoard());
+
+  subject->solveBoard();
+
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+
+  bool result(true);
+
+  for ( auto &sgp : initialBoard )
+  {
+    if ( ! subject->getSudokuGridPoint(sgp.getX(), sgp.getY()).shallowEquals(sgp) )
+    {
+      result = false;
+    }
+  }
+
+  CPPUNIT_ASSERT( result );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSearchBoardPausesAndResumes()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  boost::shared_ptr<SudokuBoard> expected(createSubject());
+
+  expected->solveBoard();
+
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::NotStarted );
+
+  // Make one guess at a time until solved.
+  unsigned long calls(0);
+  while ( subject->searchBoard(1) == SudokuBoard::SearchState::Paused )
+  {
+    ++calls;
+    CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+  }
+
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Solved );
+  CPPUNIT_ASSERT( subject->isBoardSolvable() );
+  CPPUNIT_ASSERT_EQUAL( expected->getSearchGuesses(), subject->getSearchGuesses() );
+  // The call making the last guess finds the board solved, so it is not counted.
+  CPPUNIT_ASSERT_EQUAL( calls + 1, subject->getSearchGuesses() );
+
+  short expectedArray[9][9];
+  short resultArray[9][9];
+
+  sudokuBoardToArray(expected->getSudokuBoard(), expectedArray);
+  sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+  CPPUNIT_ASSERT( std::equal(&expectedArray[0][0], &expectedArray[0][0] + 81, &resultArray[0][0]) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSearchBoardExhaustedIfNotSolvable()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT( subject->searchBoard() == SudokuBoard::SearchState::Exhausted );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject->getSearchDepth() );
+  CPPUNIT_ASSERT( subject->getSearchGuesses() > 0 );
+
+  // Pausing after every guess, including while backtracking, gives the same result.
+  boost::shared_ptr<SudokuBoard> stepped(createSubject());
+
+  while ( stepped->searchBoard(1) == SudokuBoard::SearchState::Paused )
+  {
+    for ( unsigned int depth(0); depth < stepped->getSearchDepth(); ++depth )
+    {
+      CPPUNIT_ASSERT( stepped->getSearchGuess(depth).getValue() != 0 );
+    }
+  }
+
+  CPPUNIT_ASSERT( stepped->getSearchState() == SudokuBoard::SearchState::Exhausted );
+  CPPUNIT_ASSERT_EQUAL( subject->getSearchGuesses(), stepped->getSearchGuesses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSearchBoardExhaustedIfInvalid()
+{
+  copyBoardArray(sameNumberInRowBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT( subject->searchBoard() == SudokuBoard::SearchState::Exhausted );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->getSearchGuesses() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSearchStatistics()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT( subject->searchBoard() == SudokuBoard::SearchState::Exhausted );
+
+  const SearchStatistics statistics(subject->getStatistics());
+
+  if ( ! SearchStatistics::enabled )
+  {
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.nodes );
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.guesses );
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.backtracks );
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.propagations );
+    CPPUNIT_ASSERT_EQUAL( 0u, statistics.maxDepth );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t(0), statistics.populateNanoseconds );
+    CPPUNIT_ASSERT_EQUAL( std::uint64_t(0), statistics.searchNanoseconds );
+    return;
+  }
+
+  CPPUNIT_ASSERT_EQUAL( subject->getSearchGuesses(), statistics.guesses );
+  // Every grid point chosen is given up on when there is no solution.
+  CPPUNIT_ASSERT( statistics.nodes > 0 );
+  CPPUNIT_ASSERT_EQUAL( statistics.nodes, statistics.backtracks );
+  CPPUNIT_ASSERT( statistics.guesses >= statistics.nodes );
+  CPPUNIT_ASSERT( statistics.propagations > 0 );
+  CPPUNIT_ASSERT( statistics.maxDepth > 0 && statistics.maxDepth <= statistics.nodes );
+  CPPUNIT_ASSERT( statistics.populateNanoseconds > 0 );
+  CPPUNIT_ASSERT( statistics.searchNanoseconds >= statistics.propagateNanoseconds );
+
+  // Counting the solutions starts the search again, so gives the same counts.
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutions(2) );
+  CPPUNIT_ASSERT_EQUAL( statistics.nodes, subject->getStatistics().nodes );
+  CPPUNIT_ASSERT_EQUAL( statistics.guesses, subject->getStatistics().guesses );
+  CPPUNIT_ASSERT_EQUAL( statistics.propagations, subject->getStatistics().propagations );
+  CPPUNIT_ASSERT_EQUAL( statistics.populateNanoseconds,
+    subject->getStatistics().populateNanoseconds );
+
+  // The default board is solved by forced values alone, every value it does not have is forced.
   subject_->solveBoard();
 
-  std::vector<SudokuGridPoint> sudokuBoard( subject_->getSudokuBoard() );
+  CPPUNIT_ASSERT( subject_->isBoardSolvable() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getStatistics().nodes );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject_->getStatistics().maxDepth );
+  CPPUNIT_ASSERT_EQUAL( static_cast<unsigned long>(std::count(&testBoard[0][0],
+    &testBoard[0][0] + 81, 0)), subject_->getStatistics().propagations );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSearchStatisticsInParallel()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  const std::uint64_t populateNanoseconds(subject->getStatistics().populateNanoseconds);
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutionsInParallel(2, 4) );
+
+  const SearchStatistics statistics(subject->getStatistics());
+
+  if ( ! SearchStatistics::enabled )
+  {
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.nodes );
+    CPPUNIT_ASSERT_EQUAL( 0ul, statistics.propagations );
+    return;
+  }
+
+  // Every subproblem is searched to the end, so the work is the same however the threads share it.
+  boost::shared_ptr<SudokuBoard> again(createSubject());
+  CPPUNIT_ASSERT_EQUAL( 0ul, again->countSolutionsInParallel(2, 4) );
+
+  CPPUNIT_ASSERT( statistics.propagations > 0 );
+  CPPUNIT_ASSERT_EQUAL( statistics.nodes, again->getStatistics().nodes );
+  CPPUNIT_ASSERT_EQUAL( statistics.guesses, again->getStatistics().guesses );
+  CPPUNIT_ASSERT_EQUAL( statistics.backtracks, again->getStatistics().backtracks );
+  // The copies of the board used by the threads do not add to the time to set it up.
+  CPPUNIT_ASSERT_EQUAL( populateNanoseconds, statistics.populateNanoseconds );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolveBoardWithinLimits()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  boost::shared_ptr<SudokuBoard> expected(createSubject());
+
+  expected->solveBoard();
+
+  CPPUNIT_ASSERT( subject->solveBoard(SolveLimits::within(std::chrono::hours(1))) ==
+    SudokuBoard::SearchState::Solved );
+  CPPUNIT_ASSERT( subject->isBoardSolvable() );
+  CPPUNIT_ASSERT_EQUAL( expected->getSearchGuesses(), subject->getSearchGuesses() );
+
+  short expectedArray[9][9];
+  short resultArray[9][9];
+
+  sudokuBoardToArray(expected->getSudokuBoard(), expectedArray);
+  sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+  CPPUNIT_ASSERT( std::equal(&expectedArray[0][0], &expectedArray[0][0] + 81, &resultArray[0][0]) );
+
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+  subject = createSubject();
+
+  CPPUNIT_ASSERT( subject->solveBoard(SolveLimits::none()) ==
+    SudokuBoard::SearchState::Exhausted );
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolveBoardAbortedAfterMaxGuesses()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  const std::vector<SudokuGridPoint> initialBoard(subject->getSudokuBoard());
+
+  SolveLimits limits(SolveLimits::none());
+  limits.maxGuesses = 3;
+
+  CPPUNIT_ASSERT( subject->solveBoard(limits) == SudokuBoard::SearchState::Aborted );
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Aborted );
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject->getSearchGuesses() );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject->getSearchDepth() );
+  if ( SearchStatistics::enabled )
+  {
+    CPPUNIT_ASSERT_EQUAL( 3ul, subject->getStatistics().guesses );
+  }
+
+  for ( auto &sgp : initialBoard )
+  {
+    CPPUNIT_ASSERT( subject->getSudokuGridPoint(sgp.getX(), sgp.getY()).shallowEquals(sgp) );
+  }
+
+  // Without the limit the search starts again and finishes.
+  subject->solveBoard();
+
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Exhausted );
+  CPPUNIT_ASSERT( subject->getSearchGuesses() > 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolveBoardAbortedByDeadlineOrCancel()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  // The forced values are given, but no guesses made, after the deadline.
+  CPPUNIT_ASSERT( subject->solveBoard(SolveLimits::within(std::chrono::seconds(-1))) ==
+    SudokuBoard::SearchState::Aborted );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->getSearchGuesses() );
+
+  std::atomic<bool> cancelled(true);
+  SolveLimits limits(SolveLimits::none());
+  limits.cancelled = &cancelled;
+
+  CPPUNIT_ASSERT( subject->solveBoard(limits) == SudokuBoard::SearchState::Aborted );
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+
+  cancelled = false;
+
+  CPPUNIT_ASSERT( subject->solveBoard(limits) == SudokuBoard::SearchState::Exhausted );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolveBoardWithoutGuessesSolvesSingles()
+{
+  const std::string singles("53..7....6..195....98....6.8...6...34..8.3..17...2...6"
+    ".6....28....419..5....8..79");
+
+  SolveLimits limits(SolveLimits::none());
+  limits.maxGuesses = 0;
+
+  SudokuBoard board(singles);
+  CPPUNIT_ASSERT( board.solveBoard(limits) == SudokuBoard::SearchState::Solved );
+  CPPUNIT_ASSERT( board.isBoardSolvable() );
+  CPPUNIT_ASSERT( isBoardSolved(board) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, board.getSearchGuesses() );
+
+  SudokuBoard late(singles);
+  CPPUNIT_ASSERT( late.solveBoard(SolveLimits::within(std::chrono::seconds(-1))) ==
+    SudokuBoard::SearchState::Solved );
+  CPPUNIT_ASSERT( isBoardSolved(late) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testPlaceAndErase()
+{
+  const std::vector<SudokuGridPoint> initial(subject_->getSudokuBoard());
+
+  // 1 is possible at (0,0), and placing it is the same as starting with it.
+  CPPUNIT_ASSERT( subject_->place(0, 0, 1) );
+  copyBoardArray(testBoard, testFields_.sudokuBoardArray);
+  testFields_.sudokuBoardArray[0][0] = 1;
+  boost::shared_ptr<SudokuBoard> placed(createSubject());
+  CPPUNIT_ASSERT( boardsEqual(placed->getSudokuBoard(), subject_->getSudokuBoard()) );
+
+  // Replace the initial 9 at (0,2) with 4.
+  CPPUNIT_ASSERT( subject_->place(0, 2, 4) );
+  testFields_.sudokuBoardArray[0][2] = 4;
+  placed = createSubject();
+  CPPUNIT_ASSERT( boardsEqual(placed->getSudokuBoard(), subject_->getSudokuBoard()) );
+
+  CPPUNIT_ASSERT( subject_->place(0, 2, 9) );
+  CPPUNIT_ASSERT( subject_->erase(0, 0) );
+  CPPUNIT_ASSERT( ! subject_->erase(0, 0) );
+  CPPUNIT_ASSERT( boardsEqual(initial, subject_->getSudokuBoard()) );
+
+  // Solving then erasing abandons the solution, (0,1) has no initial value.
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( ! subject_->erase(0, 1) );
+  CPPUNIT_ASSERT( boardsEqual(initial, subject_->getSudokuBoard()) );
+  CPPUNIT_ASSERT( ! subject_->isBoardSolvable() );
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( subject_->isBoardSolvable() );
+
+  CPPUNIT_ASSERT_THROW( subject_->place(9, 0, 1), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( subject_->place(0, 0, 10), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( subject_->erase(0, -1), std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testPlaceClashMakesBoardInvalid()
+{
+  // 2 is already in the first column.
+  CPPUNIT_ASSERT( ! subject_->place(0, 0, 2) );
+  CPPUNIT_ASSERT( ! subject_->isValidBoard() );
+  CPPUNIT_ASSERT( ! subject_->isConsistent() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->countSolutions(2) );
+
+  // Erasing either 2 makes it valid again.
+  CPPUNIT_ASSERT( subject_->erase(3, 0) );
+  CPPUNIT_ASSERT( subject_->isValidBoard() );
+  CPPUNIT_ASSERT( ! subject_->place(3, 0, 2) );
+  CPPUNIT_ASSERT( ! subject_->isValidBoard() );
+  CPPUNIT_ASSERT( subject_->erase(0, 0) );
+  CPPUNIT_ASSERT( subject_->isValidBoard() );
+
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( subject_->isBoardSolvable() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testIsConsistent()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+  subject_ = createSubject();
+  CPPUNIT_ASSERT( subject_->isConsistent() );
+
+  // 1 to 8 in the first row and 9 below its last grid point leave that grid point nothing.
+  for ( short y(0); y < 8; ++y )
+  {
+    CPPUNIT_ASSERT( subject_->place(0, y, y + 1) );
+  }
+  CPPUNIT_ASSERT( subject_->place(1, 8, 9) );
+  CPPUNIT_ASSERT( subject_->isValidBoard() );
+  CPPUNIT_ASSERT( ! subject_->isConsistent() );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject_->getSudokuGridPoint(0, 8).getPossibleValuesMask() );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->countSolutions(2) );
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( ! subject_->isBoardSolvable() );
+
+  CPPUNIT_ASSERT( subject_->erase(1, 8) );
+  CPPUNIT_ASSERT( subject_->isConsistent() );
+  CPPUNIT_ASSERT_EQUAL( short(9), subject_->getSudokuGridPoint(0, 8).getPossibleValues()[0] );
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( subject_->isBoardSolvable() );
+  CPPUNIT_ASSERT( isBoardSolved(*subject_) );
+
+  // The same board given to the constructor is not consistent either, rather than throwing.
+  SudokuBoard constructed(std::string("12345678.") + std::string(8, '.') + "9" +
+    std::string(63, '.'));
+  CPPUNIT_ASSERT( constructed.isValidBoard() );
+  CPPUNIT_ASSERT( ! constructed.isConsistent() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testConstructingFromTextAndBytes()
+{
+  std::string text;
+  std::uint8_t bytes[81];
+  for ( short x(0); x < 9; ++x )
+  {
+    for ( short y(0); y < 9; ++y )
+    {
+      const short value(testBoard[x][y]);
+      text += value == 0 ? '.' : static_cast<char>('0' + value);
+      bytes[x * 9 + y] = static_cast<std::uint8_t>(value);
+    }
+  }
+
+  const std::vector<SudokuGridPoint> expected(subject_->getSudokuBoard());
+  CPPUNIT_ASSERT( boardsEqual(expected, SudokuBoard(text).getSudokuBoard()) );
+  CPPUNIT_ASSERT( boardsEqual(expected, SudokuBoard(text.c_str(), text.size()).getSudokuBoard()) );
+  CPPUNIT_ASSERT( boardsEqual(expected, SudokuBoard(bytes).getSudokuBoard()) );
+
+  // '0' is an empty grid point as well as '.'.
+  std::replace(text.begin(), text.end(), '.', '0');
+  CPPUNIT_ASSERT( boardsEqual(expected, SudokuBoard(text).getSudokuBoard()) );
+
+  SudokuBoard board(text);
+  board.solveBoard();
+  CPPUNIT_ASSERT( board.isBoardSolvable() );
+  CPPUNIT_ASSERT( isBoardSolved(board) );
+
+  bytes[5] = 10;
+  CPPUNIT_ASSERT_THROW( SudokuBoard{bytes}, std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testExceptionThrownForBadText()
+{
+  try
+  {
+    (void)SudokuBoard(std::string(80, '.'));
+
+    // Should not reach here!
+    CPPUNIT_ASSERT(false);
+  }
+  catch ( std::invalid_argument &e )
+  {
+    CPPUNIT_ASSERT( e.what() == std::string("Board has 80 characters, not 81") );
+  }
+
+  std::string text(81, '.');
+  text[13] = 'x';
+  try
+  {
+    (void)SudokuBoard(text);
+
+    // Should not reach here!
+    CPPUNIT_ASSERT(false);
+  }
+  catch ( std::invalid_argument &e )
+  {
+    CPPUNIT_ASSERT( e.what() == std::string("Grid point (1,4) has character 'x'") );
+  }
+
+  // Letters are values above 9, so too big for this board.
+  text[13] = 'A';
+  CPPUNIT_ASSERT_THROW( SudokuBoard{text}, std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testGetSearchGuess()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+  subject_ = createSubject();
+
+  CPPUNIT_ASSERT( subject_->searchBoard(3) == SudokuBoard::SearchState::Paused );
+  CPPUNIT_ASSERT( subject_->getSearchDepth() > 0 );
+
+  for ( unsigned int depth(0); depth < subject_->getSearchDepth(); ++depth )
+  {
+    SudokuGridPoint guess(subject_->getSearchGuess(depth));
+
+    // The guess is also on the board.
+    CPPUNIT_ASSERT( guess.getValue() >= 1 && guess.getValue() <= 9 );
+    CPPUNIT_ASSERT( subject_->getSudokuGridPoint(guess.getX(), guess.getY()).shallowEquals(guess) );
+  }
+
+  try
+  {
+    (void)subject_->getSearchGuess(subject_->getSearchDepth());
+
+    // Should not reach here!
+    CPPUNIT_ASSERT(false);
+  }
+  catch ( std::out_of_range &e )
+  {
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testForcedValuesSolveWithoutGuessing()
+{
+  // The default board only needs naked and hidden singles.
+  CPPUNIT_ASSERT( subject_->searchBoard() == SudokuBoard::SearchState::Solved );
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject_->getSearchGuesses() );
+  CPPUNIT_ASSERT_EQUAL( 0u, subject_->getSearchDepth() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolvingWithDancingLinks()
+{
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  // Pause the search first, the DancingLinks engine should abandon it.
+  subject->searchBoard(2);
+  subject->solveBoard(SudokuBoard::SolverEngine::DancingLinks);
+  subject_->solveBoard(SudokuBoard::SolverEngine::Backtracking);
+
+  CPPUNIT_ASSERT( subject->isBoardSolvable() );
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Solved );
+
+  short expectedArray[9][9];
+  short resultArray[9][9];
+
+  sudokuBoardToArray(subject_->getSudokuBoard(), expectedArray);
+  sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+  // The test board only has one solution.
+  CPPUNIT_ASSERT( std::equal(&expectedArray[0][0], &expectedArray[0][0] + 81, &resultArray[0][0]) );
+
+  // Every grid point has been given its value.
+  for ( auto &sgp : subject->getSudokuBoard() )
+  {
+    CPPUNIT_ASSERT_EQUAL( static_cast<ValueMask>(0), sgp.getPossibleValuesMask() );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testDancingLinksBoardValidButNotSolvable()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  subject->solveBoard(SudokuBoard::SolverEngine::DancingLinks);
+
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+  CPPUNIT_ASSERT( subject->isValidBoard() );
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Exhausted );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolvingWithBitBoard()
+{
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  subject->solveBoard(SudokuBoard::SolverEngine::BitBoard);
+  subject_->solveBoard(SudokuBoard::SolverEngine::Backtracking);
+
+  CPPUNIT_ASSERT( subject->isBoardSolvable() );
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Solved );
+
+  short expectedArray[9][9];
+  short resultArray[9][9];
+
+  sudokuBoardToArray(subject_->getSudokuBoard(), expectedArray);
+  sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+  CPPUNIT_ASSERT( std::equal(&expectedArray[0][0], &expectedArray[0][0] + 81, &resultArray[0][0]) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsOfUniqueBoard()
+{
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(2) );
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(100) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsOfBoardWithSeveralSolutions()
+{
+  // Without the 5 at (8,3) the test board has two solutions.
+  testFields_.sudokuBoardArray[8][3] = 0;
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject->countSolutions(2) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject->countSolutions(100) );
+
+  // Without the 3 at (1,1) as well it has three.
+  testFields_.sudokuBoardArray[8][3] = 5;
+  testFields_.sudokuBoardArray[1][1] = 0;
+  subject = createSubject();
+
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject->countSolutions(100) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsStopsAtLimit()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutions(0) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject->countSolutions(2) );
+  CPPUNIT_ASSERT_EQUAL( 1000ul, subject->countSolutions(1000) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsOfBoardsWithNoSolution()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutions(2) );
+
+  copyBoardArray(sameNumberInRowBoard, testFields_.sudokuBoardArray);
+  subject = createSubject();
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutions(2) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsRestoresBoard()
+{
+  const std::vector<SudokuGridPoint> initialBoard(subject_->getSudokuBoard());
+
+  // Count part way through a search, and after it is solved.
+  subject_->searchBoard(0);
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(2) );
+  subject_->solveBoard();
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutions(2) );
+
+  CPPUNIT_ASSERT( subject_->getSearchState() == SudokuBoard::SearchState::NotStarted );
+  CPPUNIT_ASSERT( ! subject_->isBoardSolvable() );
+
+  // Nor is it left solved by visiting or counting in parallel after solving it.
+  subject_->solveBoard();
+  CPPUNIT_ASSERT_EQUAL( 1ul,
+    subject_->visitSolutions([]( const SudokuBoard::SolutionGrid& ) { return true; }) );
+  CPPUNIT_ASSERT( ! subject_->isBoardSolvable() );
+  subject_->solveBoard();
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutionsInParallel(2, 2) );
+  CPPUNIT_ASSERT( ! subject_->isBoardSolvable() );
 
   bool result(true);
 
-  for ( std::vector<SudokuGridPoint>::size_type i(0); i < sudokuBoard.size() - 1; ++i )
+  for ( auto &sgp : initialBoard )
   {
-    if ( sudokuBoard.at(i) > sudokuBoard.at(i + 1) )
+    if ( ! subject_->getSudokuGridPoint(sgp.getX(), sgp.getY()).shallowEquals(sgp) )
     {
       result = false;
     }
   }
 
   CPPUNIT_ASSERT( result );
+
+  // The board can still be solved afterwards.
+  subject_->solveBoard();
+  CPPUNIT_ASSERT( subject_->getSearchState() == SudokuBoard::SearchState::Solved );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testVisitSolutionsOfUniqueBoard()
+{
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  subject->solveBoard();
+
+  short expectedArray[9][9];
+  sudokuBoardToArray(subject->getSudokuBoard(), expectedArray);
+
+  SudokuBoard::SolutionGrid visited;
+  visited.fill(0);
+
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->visitSolutions(
+    [&visited]( const SudokuBoard::SolutionGrid& grid ) { visited = grid; return true; }) );
+  CPPUNIT_ASSERT( std::equal(visited.begin(), visited.end(), &expectedArray[0][0]) );
+  CPPUNIT_ASSERT( subject_->getSearchState() == SudokuBoard::SearchState::NotStarted );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testVisitSolutionsOfBoardWithSeveralSolutions()
+{
+  // Without the 3 at (1,1) the test board has three solutions.
+  testFields_.sudokuBoardArray[1][1] = 0;
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  std::vector<SudokuBoard::SolutionGrid> solutions;
+
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject->visitSolutions(
+    [&solutions]( const SudokuBoard::SolutionGrid& grid )
+    {
+      solutions.push_back(grid);
+      return true;
+    }) );
+
+  std::sort(solutions.begin(), solutions.end());
+  CPPUNIT_ASSERT( std::unique(solutions.begin(), solutions.end()) == solutions.end() );
+
+  for ( auto &solution : solutions )
+  {
+    // Each solution keeps the initial values, and solves the board with the solution as its
+    // initial values.
+    short solutionArray[9][9];
+    for ( short i(0); i < 81; ++i )
+    {
+      const short initialValue(testFields_.sudokuBoardArray[i / 9][i % 9]);
+      CPPUNIT_ASSERT( initialValue == 0 || initialValue == solution[i] );
+      solutionArray[i / 9][i % 9] = solution[i];
+    }
+
+    SudokuBoard solved(solutionArray);
+    CPPUNIT_ASSERT( solved.isValidBoard() );
+    CPPUNIT_ASSERT_EQUAL( 1ul, solved.countSolutions(2) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testVisitSolutionsStoppedByVisitor()
+{
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  unsigned long calls(0);
+
+  CPPUNIT_ASSERT_EQUAL( 10ul, subject->visitSolutions(
+    [&calls]( const SudokuBoard::SolutionGrid& ) { return ++calls < 10; }) );
+  CPPUNIT_ASSERT_EQUAL( 10ul, calls );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testVisitSolutionsOfBoardWithNoSolution()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  unsigned long calls(0);
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->visitSolutions(
+    [&calls]( const SudokuBoard::SolutionGrid& ) { ++calls; return true; }) );
+  CPPUNIT_ASSERT_EQUAL( 0ul, calls );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolvingInParallel()
+{
+  for ( unsigned int threads(1); threads <= 4; ++threads )
+  {
+    boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+    // Pause the search first, it should be abandoned.
+    subject->searchBoard(1);
+    subject->solveBoardInParallel(threads);
+    subject_->solveBoard();
+
+    CPPUNIT_ASSERT( subject->isBoardSolvable() );
+    CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Solved );
+
+    short expectedArray[9][9];
+    short resultArray[9][9];
+
+    sudokuBoardToArray(subject_->getSudokuBoard(), expectedArray);
+    sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+    CPPUNIT_ASSERT( std::equal(&expectedArray[0][0], &expectedArray[0][0] + 81,
+      &resultArray[0][0]) );
+  }
+
+  // A board with many solutions gives one of them.
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+  subject->solveBoardInParallel(4);
+
+  short resultArray[9][9];
+  sudokuBoardToArray(subject->getSudokuBoard(), resultArray);
+
+  SudokuBoard solved(resultArray);
+  CPPUNIT_ASSERT( solved.isValidBoard() );
+  CPPUNIT_ASSERT_EQUAL( 1ul, solved.countSolutions(2) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolvingInParallelBoardValidButNotSolvable()
+{
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  subject->solveBoardInParallel(4);
+
+  CPPUNIT_ASSERT( ! subject->isBoardSolvable() );
+  CPPUNIT_ASSERT( subject->getSearchState() == SudokuBoard::SearchState::Exhausted );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testCountSolutionsInParallel()
+{
+  CPPUNIT_ASSERT_EQUAL( 1ul, subject_->countSolutionsInParallel(2, 4) );
+
+  // Without the 3 at (1,1) the test board has three solutions.
+  testFields_.sudokuBoardArray[1][1] = 0;
+  boost::shared_ptr<SudokuBoard> subject(createSubject());
+
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject->countSolutionsInParallel(100, 4) );
+  CPPUNIT_ASSERT_EQUAL( 2ul, subject->countSolutionsInParallel(2, 4) );
+  CPPUNIT_ASSERT_EQUAL( 3ul, subject->countSolutionsInParallel(100, 1) );
+
+  copyBoardArray(zeroesBoard, testFields_.sudokuBoardArray);
+  subject = createSubject();
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutionsInParallel(0, 4) );
+  CPPUNIT_ASSERT_EQUAL( 1000ul, subject->countSolutionsInParallel(1000, 4) );
+
+  copyBoardArray(nonSolvableTestBoard, testFields_.sudokuBoardArray);
+  subject = createSubject();
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutionsInParallel(2, 4) );
+
+  copyBoardArray(sameNumberInRowBoard, testFields_.sudokuBoardArray);
+  subject = createSubject();
+
+  CPPUNIT_ASSERT_EQUAL( 0ul, subject->countSolutionsInParallel(2, 4) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolving4x4Board()
+{
+  typedef BasicSudokuBoard<2> Board;
+  short boardArray[4][4] =
+  {
+  {1, 0, 0, 0},
+  {0, 0, 3, 0},
+  {0, 4, 0, 0},
+  {0, 0, 0, 2}
+  };
+
+  Board backtracking(boardArray);
+  Board dancingLinks(boardArray);
+
+  CPPUNIT_ASSERT( backtracking.isValidBoard() );
+  backtracking.solveBoard(Board::SolverEngine::Backtracking);
+  dancingLinks.solveBoard(Board::SolverEngine::DancingLinks);
+
+  CPPUNIT_ASSERT( backtracking.isBoardSolvable() );
+  CPPUNIT_ASSERT( dancingLinks.isBoardSolvable() );
+  CPPUNIT_ASSERT( isBoardSolved(backtracking) );
+  CPPUNIT_ASSERT( isBoardSolved(dancingLinks) );
+  CPPUNIT_ASSERT_EQUAL( short(1), backtracking.getSudokuGridPoint(0, 0).getValue() );
+  CPPUNIT_ASSERT_EQUAL( short(3), backtracking.getSudokuGridPoint(1, 2).getValue() );
+  CPPUNIT_ASSERT_EQUAL( short(4), backtracking.getSudokuGridPoint(2, 1).getValue() );
+  CPPUNIT_ASSERT_EQUAL( short(2), backtracking.getSudokuGridPoint(3, 3).getValue() );
+
+  // There are 288 completed 4x4 boards.
+  short emptyArray[4][4] = {};
+  Board empty(emptyArray);
+  CPPUNIT_ASSERT_EQUAL( 288ul, empty.countSolutions(1000) );
+  CPPUNIT_ASSERT_EQUAL( 288ul, empty.countSolutionsInParallel(1000, 4) );
+
+  boardArray[0][3] = 1;
+  Board invalid(boardArray);
+  CPPUNIT_ASSERT( ! invalid.isValidBoard() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testSolving16x16Board()
+{
+  typedef BasicSudokuBoard<4> Board;
+  short boardArray[16][16] = {};
+
+  // Give the first row in reverse, and the first column in a different order.
+  for ( short i(0); i < 16; ++i )
+  {
+    boardArray[0][i] = static_cast<short>(16 - i);
+  }
+  boardArray[1][0] = 1;
+  boardArray[4][0] = 2;
+  boardArray[8][0] = 3;
+  boardArray[12][0] = 4;
+
+  Board backtracking(boardArray);
+  Board dancingLinks(boardArray);
+
+  backtracking.solveBoard(Board::SolverEngine::Backtracking);
+  dancingLinks.solveBoard(Board::SolverEngine::DancingLinks);
+
+  CPPUNIT_ASSERT( backtracking.isBoardSolvable() );
+  CPPUNIT_ASSERT( dancingLinks.isBoardSolvable() );
+  CPPUNIT_ASSERT( isBoardSolved(backtracking) );
+  CPPUNIT_ASSERT( isBoardSolved(dancingLinks) );
+  CPPUNIT_ASSERT_EQUAL( short(16), backtracking.getSudokuGridPoint(0, 0).getValue() );
+  CPPUNIT_ASSERT_EQUAL( short(3), dancingLinks.getSudokuGridPoint(8, 0).getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuBoardTest::testOtherBoardSizesCheckBounds()
+{
+  typedef BasicSudokuBoard<2> Board;
+  short boardArray[4][4] = {};
+  Board board(boardArray);
+
+  CPPUNIT_ASSERT_THROW( board.getSudokuGridPoint(4, 0), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( board.getSudokuGridPoint(0, 4), std::invalid_argument );
+  CPPUNIT_ASSERT_THROW( board.solveBoard(Board::SolverEngine::BitBoard), std::invalid_argument );
+
+  boardArray[1][2] = 5;
+  try
+  {
+    Board tooBig(boardArray);
+
+    // Should not reach here!
+    CPPUNIT_ASSERT(false);
+  }
+  catch ( std::invalid_argument &e )
+  {
+    CPPUNIT_ASSERT( e.what() == std::string("Grid point (1,2) has value > 4") );
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -33,7 +33,42 @@ class SudokuBoardTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testSolvingGoodBoard);
   CPPUNIT_TEST(testSolvingZeroesBoard);
   CPPUNIT_TEST(testBoardValidButNotSolvable);
-  CPPUNIT_TEST(testBoardOrdered);
+  CPPUNIT_TEST(testBoardStoredRowByRow);
+  CPPUNIT_TEST(testBoardRestoredIfNotSolvable);
+  CPPUNIT_TEST(testSearchBoardPausesAndResumes);
+  CPPUNIT_TEST(testSearchBoardExhaustedIfNotSolvable);
+  CPPUNIT_TEST(testSearchBoardExhaustedIfInvalid);
+  CPPUNIT_TEST(testSearchStatistics);
+  CPPUNIT_TEST(testSearchStatisticsInParallel);
+  CPPUNIT_TEST(testSolveBoardWithinLimits);
+  CPPUNIT_TEST(testSolveBoardAbortedAfterMaxGuesses);
+  CPPUNIT_TEST(testSolveBoardAbortedByDeadlineOrCancel);
+  CPPUNIT_TEST(testSolveBoardWithoutGuessesSolvesSingles);
+  CPPUNIT_TEST(testPlaceAndErase);
+  CPPUNIT_TEST(testPlaceClashMakesBoardInvalid);
+  CPPUNIT_TEST(testIsConsistent);
+  CPPUNIT_TEST(testConstructingFromTextAndBytes);
+  CPPUNIT_TEST(testExceptionThrownForBadText);
+  CPPUNIT_TEST(testGetSearchGuess);
+  CPPUNIT_TEST(testForcedValuesSolveWithoutGuessing);
+  CPPUNIT_TEST(testSolvingWithDancingLinks);
+  CPPUNIT_TEST(testDancingLinksBoardValidButNotSolvable);
+  CPPUNIT_TEST(testSolvingWithBitBoard);
+  CPPUNIT_TEST(testCountSolutionsOfUniqueBoard);
+  CPPUNIT_TEST(testCountSolutionsOfBoardWithSeveralSolutions);
+  CPPUNIT_TEST(testCountSolutionsStopsAtLimit);
+  CPPUNIT_TEST(testCountSolutionsOfBoardsWithNoSolution);
+  CPPUNIT_TEST(testCountSolutionsRestoresBoard);
+  CPPUNIT_TEST(testVisitSolutionsOfUniqueBoard);
+  CPPUNIT_TEST(testVisitSolutionsOfBoardWithSeveralSolutions);
+  CPPUNIT_TEST(testVisitSolutionsStoppedByVisitor);
+  CPPUNIT_TEST(testVisitSolutionsOfBoardWithNoSolution);
+  CPPUNIT_TEST(testSolvingInParallel);
+  CPPUNIT_TEST(testSolvingInParallelBoardValidButNotSolvable);
+  CPPUNIT_TEST(testCountSolutionsInParallel);
+  CPPUNIT_TEST(testSolving4x4Board);
+  CPPUNIT_TEST(testSolving16x16Board);
+  CPPUNIT_TEST(testOtherBoardSizesCheckBounds);
   CPPUNIT_TEST_SUITE_END();
   
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,8 +111,113 @@ class SudokuBoardTest : public CppUnit::TestFixture
     // \test Test solving a board that is valid but not solvable.
     void testBoardValidButNotSolvable();
 
-    // \test Test that the Sudoku Board is ordered.
-    void testBoardOrdered();
+    // \test Test that the Sudoku Board is stored row by row, before and after solving.
+    void testBoardStoredRowByRow();
+
+    // \test Test that every possible value removed while solving is restored if not solvable.
+    void testBoardRestoredIfNotSolvable();
+
+    // \test Test that a paused search resumes and finds the same solution as solveBoard.
+    void testSearchBoardPausesAndResumes();
+
+    // \test Test the search state of a board that is valid but not solvable.
+    void testSearchBoardExhaustedIfNotSolvable();
+
+    // \test Test the search state of a board that is not valid.
+    void testSearchBoardExhaustedIfInvalid();
+
+    // \test Test the statistics of a search are kept if enabled, and cleared when it restarts.
+    void testSearchStatistics();
+
+    // \test Test the statistics of a parallel search add up the work of each thread.
+    void testSearchStatisticsInParallel();
+
+    // \test Test solving with limits that are not reached gives the same result as solveBoard.
+    void testSolveBoardWithinLimits();
+
+    // \test Test a search is aborted and undone after the most guesses, and can be started again.
+    void testSolveBoardAbortedAfterMaxGuesses();
+
+    // \test Test a search is aborted once its deadline has passed or it is cancelled.
+    void testSolveBoardAbortedByDeadlineOrCancel();
+
+    // \test Test a board the forced values solve is solved with no guesses or time allowed.
+    void testSolveBoardWithoutGuessesSolvesSingles();
+
+    // \test Test placing and erasing values gives the same board as constructing it with them.
+    void testPlaceAndErase();
+
+    // \test Test placing a value already in a unit makes the board invalid until one is erased.
+    void testPlaceClashMakesBoardInvalid();
+
+    // \test Test a board with a grid point left with no possible values is not consistent.
+    void testIsConsistent();
+
+    // \test Test constructing from text or bytes gives the same board as from the array.
+    void testConstructingFromTextAndBytes();
+
+    // \test Test an exception is thrown for text of the wrong length or with a bad character.
+    void testExceptionThrownForBadText();
+
+    // \test Test inspecting the guesses of a paused search.
+    void testGetSearchGuess();
+
+    // \test Test that a board solvable with naked and hidden singles needs no guesses.
+    void testForcedValuesSolveWithoutGuessing();
+
+    // \test Test solving a good board with the DancingLinks engine gives the same solution.
+    void testSolvingWithDancingLinks();
+
+    // \test Test solving a board that is valid but not solvable with the DancingLinks engine.
+    void testDancingLinksBoardValidButNotSolvable();
+
+    // \test Test solving a good board with the BitBoard engine gives the same solution.
+    void testSolvingWithBitBoard();
+
+    // \test Test counting the solutions of a board with one solution.
+    void testCountSolutionsOfUniqueBoard();
+
+    // \test Test counting the solutions of boards with two and three solutions.
+    void testCountSolutionsOfBoardWithSeveralSolutions();
+
+    // \test Test counting stops once the limit is reached.
+    void testCountSolutionsStopsAtLimit();
+
+    // \test Test counting the solutions of invalid and valid but not solvable boards.
+    void testCountSolutionsOfBoardsWithNoSolution();
+
+    // \test Test the board is returned to how it was constructed after counting.
+    void testCountSolutionsRestoresBoard();
+
+    // \test Test visiting the solution of a board with one solution.
+    void testVisitSolutionsOfUniqueBoard();
+
+    // \test Test visiting the solutions of a board with three solutions.
+    void testVisitSolutionsOfBoardWithSeveralSolutions();
+
+    // \test Test the visitor can stop the enumeration early.
+    void testVisitSolutionsStoppedByVisitor();
+
+    // \test Test the visitor is not called for a board with no solution.
+    void testVisitSolutionsOfBoardWithNoSolution();
+
+    // \test Test solving good boards in parallel gives the same solution.
+    void testSolvingInParallel();
+
+    // \test Test solving a board that is valid but not solvable in parallel.
+    void testSolvingInParallelBoardValidButNotSolvable();
+
+    // \test Test counting solutions in parallel.
+    void testCountSolutionsInParallel();
+
+    // \test Test solving and counting the solutions of 4x4 boards with each engine.
+    void testSolving4x4Board();
+
+    // \test Test solving a 16x16 board with each engine.
+    void testSolving16x16Board();
+
+    // \test Test values and grid points outside a 4x4 board, and the BitBoard engine, are rejected.
+    void testOtherBoardSizesCheckBounds();
 
   //////////////////////////////////////////////////////////////////////////////////////////////////
   /// Private types and variables.
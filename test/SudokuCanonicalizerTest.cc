@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for SudokuTransform and SudokuCanonicalizer.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "src/SudokuCanonicalizer.h"
+#include "SudokuCanonicalizerTest.h"
+#include "TestBoards.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SudokuCanonicalizerTest );
+
+namespace
+{
+
+using sudoku::testboards::alEscargot;
+using sudoku::testboards::nonSolvableTestBoard;
+using sudoku::testboards::testBoard;
+using sudoku::testboards::testBoardSolution;
+
+} // End of anonymous namespace.
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testApplyingTransform()
+{
+  SudokuTransform transform(SudokuTransform::identity());
+  short result[81];
+
+  transform.apply(testBoard, result);
+  CPPUNIT_ASSERT( std::equal(result, result + 81, testBoard) );
+
+  // Swap the first two bands, the last two columns, and the values 3 and 9.
+  const short rows[9] = { 3, 4, 5, 0, 1, 2, 6, 7, 8 };
+  const short columns[9] = { 0, 1, 2, 3, 4, 5, 6, 8, 7 };
+  std::copy(rows, rows + 9, transform.rows);
+  std::copy(columns, columns + 9, transform.columns);
+  std::swap(transform.values[3], transform.values[9]);
+
+  transform.apply(testBoard, result);
+  for ( short row(0); row < 9; ++row )
+  {
+    for ( short column(0); column < 9; ++column )
+    {
+      short value(testBoard[rows[row] * 9 + columns[column]]);
+      value = value == 3 ? 9 : value == 9 ? 3 : value;
+      CPPUNIT_ASSERT_EQUAL( value, result[row * 9 + column] );
+    }
+  }
+
+  // The swap comes first.
+  transform = SudokuTransform::identity();
+  transform.transpose = true;
+  transform.rows[0] = 1;
+  transform.rows[1] = 0;
+  transform.apply(testBoard, result);
+  for ( short column(0); column < 9; ++column )
+  {
+    CPPUNIT_ASSERT_EQUAL( testBoard[column * 9 + 1], result[column] );
+    CPPUNIT_ASSERT_EQUAL( testBoard[column * 9], result[9 + column] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testInverseUndoesTransform()
+{
+  std::mt19937 random(1);
+  short transformed[81];
+  short result[81];
+
+  for ( short i(0); i < 100; ++i )
+  {
+    const SudokuTransform transform(makeRandomTransform(random));
+    transform.apply(testBoardSolution, transformed);
+    transform.inverse().apply(transformed, result);
+    CPPUNIT_ASSERT( std::equal(result, result + 81, testBoardSolution) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testTransformMakesCanonicalForm()
+{
+  SudokuCanonicalizer subject;
+  short canonical[81];
+  short result[81];
+
+  for ( auto board : { &testBoard, &testBoardSolution, &alEscargot } )
+  {
+    const SudokuTransform transform(subject.canonicalize(*board, canonical));
+    transform.apply(*board, result);
+    CPPUNIT_ASSERT( std::equal(result, result + 81, canonical) );
+
+    short again[81];
+    subject.canonicalize(canonical, again);
+    CPPUNIT_ASSERT( std::equal(again, again + 81, canonical) );
+  }
+
+  // The test board has a row with no values, which can be moved to the top.
+  subject.canonicalize(testBoard, canonical);
+  CPPUNIT_ASSERT( std::count(canonical, canonical + 9, 0) == 9 );
+
+  // The first row of a full board can always be relabelled to 1 to 9.
+  subject.canonicalize(testBoardSolution, canonical);
+  for ( short i(0); i < 9; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( static_cast<short>(i + 1), canonical[i] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testTransformedBoardsHaveSameCanonicalForm()
+{
+  SudokuCanonicalizer subject;
+  std::mt19937 random(2);
+
+  for ( auto board : { &testBoard, &testBoardSolution } )
+  {
+    short expected[81];
+    subject.canonicalize(*board, expected);
+
+    for ( short i(0); i < 10; ++i )
+    {
+      short transformed[81];
+      short canonical[81];
+      makeRandomTransform(random).apply(*board, transformed);
+      subject.canonicalize(transformed, canonical);
+      CPPUNIT_ASSERT( std::equal(canonical, canonical + 81, expected) );
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testDifferentBoardsHaveDifferentCanonicalForms()
+{
+  SudokuCanonicalizer subject;
+  short first[81];
+  short second[81];
+
+  subject.canonicalize(testBoard, first);
+  subject.canonicalize(alEscargot, second);
+  CPPUNIT_ASSERT( ! std::equal(first, first + 81, second) );
+
+  // Swapping two values in one row only gives a board that is not valid, so not a transform.
+  short changed[81];
+  std::copy(testBoardSolution, testBoardSolution + 81, changed);
+  std::swap(changed[0], changed[1]);
+  subject.canonicalize(testBoardSolution, first);
+  subject.canonicalize(changed, second);
+  CPPUNIT_ASSERT( ! std::equal(first, first + 81, second) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testCanonicalizingSudokuBoard()
+{
+  SudokuCanonicalizer subject;
+  SudokuTransform transform;
+  SudokuBoard canonicalBoard(subject.canonicalize(SudokuBoard(testBoard), transform));
+
+  short expected[81];
+  short values[81];
+  subject.canonicalize(testBoard, expected);
+  canonicalBoard.getValues(values);
+  CPPUNIT_ASSERT( std::equal(values, values + 81, expected) );
+
+  // The solution of the canonical board taken back by the inverse is the solution of the board.
+  canonicalBoard.solveBoard();
+  canonicalBoard.getValues(values);
+  short solution[81];
+  transform.inverse().apply(values, solution);
+  CPPUNIT_ASSERT( std::equal(solution, solution + 81, testBoardSolution) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testExceptionThrownIfValueInvalid()
+{
+  SudokuCanonicalizer subject;
+  short board[81];
+  short canonical[81];
+  std::copy(testBoard, testBoard + 81, board);
+
+  board[80] = 10;
+  CPPUNIT_ASSERT_THROW( subject.canonicalize(board, canonical), std::invalid_argument );
+  board[80] = -1;
+  CPPUNIT_ASSERT_THROW( subject.canonicalize(board, canonical), std::invalid_argument );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testBoardWithRepeatedValue()
+{
+  SudokuCanonicalizer subject;
+  std::mt19937 random(3);
+  short board[81];
+  std::copy(testBoard, testBoard + 81, board);
+  board[0] = 3;
+
+  short expected[81];
+  subject.canonicalize(board, expected);
+  for ( short i(0); i < 5; ++i )
+  {
+    short transformed[81];
+    short canonical[81];
+    makeRandomTransform(random).apply(board, transformed);
+    const SudokuTransform transform(subject.canonicalize(transformed, canonical));
+    CPPUNIT_ASSERT( std::equal(canonical, canonical + 81, expected) );
+
+    short result[81];
+    transform.apply(transformed, result);
+    CPPUNIT_ASSERT( std::equal(result, result + 81, expected) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testEmptyBoard()
+{
+  SudokuCanonicalizer subject;
+  const short board[81] = { 0 };
+  short canonical[81];
+  short result[81];
+
+  const SudokuTransform transform(subject.canonicalize(board, canonical));
+  CPPUNIT_ASSERT( std::count(canonical, canonical + 81, 0) == 81 );
+  transform.apply(board, result);
+  CPPUNIT_ASSERT( std::count(result, result + 81, 0) == 81 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuCanonicalizerTest::testCanonicalizingIsFast()
+{
+  SudokuCanonicalizer subject;
+  std::mt19937 random(4);
+  const int numberOfPuzzles(300);
+  short puzzles[numberOfPuzzles][81];
+  short canonical[81];
+
+  for ( int i(0); i < numberOfPuzzles; ++i )
+  {
+    const short (&puzzle)[81](i % 3 == 0 ? testBoard :
+      i % 3 == 1 ? alEscargot : nonSolvableTestBoard);
+    makeRandomTransform(random).apply(puzzle, puzzles[i]);
+  }
+
+  const auto start(std::chrono::steady_clock::now());
+  for ( int i(0); i < numberOfPuzzles; ++i )
+  {
+    subject.canonicalize(puzzles[i], canonical);
+  }
+  const std::chrono::duration<double, std::micro> time(std::chrono::steady_clock::now() - start);
+  CPPUNIT_ASSERT( time.count() / numberOfPuzzles < 1000.0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+SudokuTransform SudokuCanonicalizerTest::makeRandomTransform( std::mt19937& random )
+{
+  SudokuTransform transform(SudokuTransform::identity());
+  short bands[3] = { 0, 1, 2 };
+  short stacks[3] = { 0, 1, 2 };
+
+  transform.transpose = random() % 2 == 1;
+  std::shuffle(bands, bands + 3, random);
+  std::shuffle(stacks, stacks + 3, random);
+  for ( short i(0); i < 3; ++i )
+  {
+    short rows[3] = { 0, 1, 2 };
+    short columns[3] = { 0, 1, 2 };
+    std::shuffle(rows, rows + 3, random);
+    std::shuffle(columns, columns + 3, random);
+    for ( short j(0); j < 3; ++j )
+    {
+      transform.rows[i * 3 + j] = bands[i] * 3 + rows[j];
+      transform.columns[i * 3 + j] = stacks[i] * 3 + columns[j];
+    }
+  }
+  std::shuffle(transform.values + 1, transform.values + 10, random);
+
+  return transform;
+}
+
+} // End of namespace sudoku.
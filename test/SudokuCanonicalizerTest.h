@@ -0,0 +1,84 @@
+#ifndef __sudoku_sudokucanonicalizertest_h__
+#define __sudoku_sudokucanonicalizertest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for SudokuTransform and SudokuCanonicalizer.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <random>
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/SudokuCanonicalizer.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuCanonicalizerTest class for testing SudokuTransform and SudokuCanonicalizer.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuCanonicalizerTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SudokuCanonicalizerTest);
+  CPPUNIT_TEST(testApplyingTransform);
+  CPPUNIT_TEST(testInverseUndoesTransform);
+  CPPUNIT_TEST(testTransformMakesCanonicalForm);
+  CPPUNIT_TEST(testTransformedBoardsHaveSameCanonicalForm);
+  CPPUNIT_TEST(testDifferentBoardsHaveDifferentCanonicalForms);
+  CPPUNIT_TEST(testCanonicalizingSudokuBoard);
+  CPPUNIT_TEST(testExceptionThrownIfValueInvalid);
+  CPPUNIT_TEST(testBoardWithRepeatedValue);
+  CPPUNIT_TEST(testEmptyBoard);
+  CPPUNIT_TEST(testCanonicalizingIsFast);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    /// \test Test the rows, columns, swap and values of a transform move the values as expected.
+    void testApplyingTransform();
+
+    /// \test Test the inverse of random transforms, with and without a swap, undoes them.
+    void testInverseUndoesTransform();
+
+    /// \test Test the transform given makes the canonical form, which is its own canonical form
+    /// and starts with the smallest values possible.
+    void testTransformMakesCanonicalForm();
+
+    /// \test Test random transforms of a puzzle and of a full board give the same canonical form.
+    void testTransformedBoardsHaveSameCanonicalForm();
+
+    /// \test Test boards that cannot be transformed into each other have different canonical forms.
+    void testDifferentBoardsHaveDifferentCanonicalForms();
+
+    /// \test Test the canonical form of a SudokuBoard, and that it solves to the canonical form of
+    /// the solution.
+    void testCanonicalizingSudokuBoard();
+
+    /// \test Test a value outside 0 to 9 is rejected.
+    void testExceptionThrownIfValueInvalid();
+
+    /// \test Test random transforms of a board with a value twice in a row give the same
+    /// canonical form, which the transform makes.
+    void testBoardWithRepeatedValue();
+
+    /// \test Test a board with no values is its own canonical form.
+    void testEmptyBoard();
+
+    /// \test Test canonicalizing a puzzle takes under a millisecond on average, even without
+    /// optimisation, where trying every column order took longer.
+    void testCanonicalizingIsFast();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    static SudokuTransform makeRandomTransform( std::mt19937& random ); // Makes a transform.
+};
+
+} // End of namespace sudoku.
+
+#endif
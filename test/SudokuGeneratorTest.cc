@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for SudokuGenerator.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "src/SudokuGenerator.h"
+#include "SudokuGeneratorTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SudokuGeneratorTest );
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Counts the values in a puzzle.
+/// \param puzzle The puzzle.
+/// \return The number of grid points with a value.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+static short countClues( const short (&puzzle)[81] )
+{
+  return static_cast<short>(81 - std::count(puzzle, puzzle + 81, 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testPuzzleHasOneSolution()
+{
+  short puzzle[81];
+
+  for ( std::uint64_t seed(0); seed < 10; ++seed )
+  {
+    const short clues(subject_->generate(seed, puzzle));
+
+    CPPUNIT_ASSERT_EQUAL( clues, countClues(puzzle) );
+    CPPUNIT_ASSERT_EQUAL( 1ul, solver_.countSolutions(puzzle, 2) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testNumberOfClues()
+{
+  short puzzle[81];
+
+  for ( short numberOfClues(26); numberOfClues <= 40; numberOfClues += 7 )
+  {
+    SudokuGenerator generator(numberOfClues, SudokuGenerator::Symmetry::None, 1);
+
+    CPPUNIT_ASSERT_EQUAL( numberOfClues, generator.generate(42, puzzle) );
+    CPPUNIT_ASSERT_EQUAL( numberOfClues, countClues(puzzle) );
+    CPPUNIT_ASSERT_EQUAL( 1ul, solver_.countSolutions(puzzle, 2) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testMinimalPuzzle()
+{
+  short puzzle[81];
+
+  (void)subject_->generate(7, puzzle);
+
+  for ( short i(0); i < 81; ++i )
+  {
+    if ( puzzle[i] != 0 )
+    {
+      const short value(puzzle[i]);
+      puzzle[i] = 0;
+      CPPUNIT_ASSERT_EQUAL( 2ul, solver_.countSolutions(puzzle, 2) );
+      puzzle[i] = value;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testSameSeedGivesSamePuzzle()
+{
+  short first[81];
+  short second[81];
+
+  (void)subject_->generate(1234, first);
+  (void)subject_->generate(1234, second);
+  CPPUNIT_ASSERT( std::equal(first, first + 81, second) );
+
+  (void)subject_->generate(1235, second);
+  CPPUNIT_ASSERT( ! std::equal(first, first + 81, second) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testSymmetry()
+{
+  short puzzle[81];
+
+  SudokuGenerator rotational(0, SudokuGenerator::Symmetry::Rotational, 1);
+  SudokuGenerator mirror(0, SudokuGenerator::Symmetry::Mirror, 1);
+  SudokuGenerator diagonal(0, SudokuGenerator::Symmetry::Diagonal, 1);
+
+  (void)rotational.generate(3, puzzle);
+  CPPUNIT_ASSERT_EQUAL( 1ul, solver_.countSolutions(puzzle, 2) );
+  for ( short i(0); i < 81; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( puzzle[i] == 0, puzzle[80 - i] == 0 );
+  }
+
+  (void)mirror.generate(3, puzzle);
+  CPPUNIT_ASSERT_EQUAL( 1ul, solver_.countSolutions(puzzle, 2) );
+  for ( short i(0); i < 81; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( puzzle[i] == 0, puzzle[( i / 9 ) * 9 + 8 - i % 9] == 0 );
+  }
+
+  (void)diagonal.generate(3, puzzle);
+  CPPUNIT_ASSERT_EQUAL( 1ul, solver_.countSolutions(puzzle, 2) );
+  for ( short i(0); i < 81; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( puzzle[i] == 0, puzzle[( i % 9 ) * 9 + i / 9] == 0 );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testManyPuzzlesIndependentOfThreads()
+{
+  SudokuGenerator oneThread(30, SudokuGenerator::Symmetry::Rotational, 1);
+  SudokuGenerator fourThreads(30, SudokuGenerator::Symmetry::Rotational, 4);
+  std::vector<std::string> first;
+  std::vector<std::string> second;
+  short puzzle[81];
+
+  std::vector<short> clues;
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(0), oneThread.generate(99, 50, first, 0, &clues) );
+  fourThreads.generate(99, 50, second);
+  CPPUNIT_ASSERT_EQUAL( std::size_t(50), clues.size() );
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(50), first.size() );
+  CPPUNIT_ASSERT( first == second );
+
+  // The sequence can be made a part at a time.
+  fourThreads.generate(99, 30, second, 20);
+  CPPUNIT_ASSERT( std::equal(second.begin(), second.begin() + 30, first.begin() + 20) );
+
+  CPPUNIT_ASSERT_EQUAL( clues[0], oneThread.generate(99, puzzle) );
+  for ( short i(0); i < 81; ++i )
+  {
+    CPPUNIT_ASSERT_EQUAL( puzzle[i] == 0 ? '.' : static_cast<char>('0' + puzzle[i]),
+      first[0][i] );
+  }
+  for ( std::size_t number(0); number < first.size(); ++number )
+  {
+    CPPUNIT_ASSERT_EQUAL( clues[number],
+      static_cast<short>(81 - std::count(first[number].begin(), first[number].end(), '.')) );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::testPuzzlesWithTooManyCluesCounted()
+{
+  // A rotationally symmetric puzzle with 17 values is too rare to be found.
+  SudokuGenerator generator(17, SudokuGenerator::Symmetry::Rotational, 4);
+  std::vector<std::string> puzzles;
+  std::vector<short> clues;
+
+  CPPUNIT_ASSERT_EQUAL( std::size_t(5), generator.generate(99, 5, puzzles, 0, &clues) );
+  CPPUNIT_ASSERT_EQUAL( std::size_t(5), clues.size() );
+  for ( auto clue : clues )
+  {
+    CPPUNIT_ASSERT( clue > 17 );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+boost::shared_ptr<SudokuGenerator> SudokuGeneratorTest::createSubject()
+{
+  boost::shared_ptr<SudokuGenerator> subject(new SudokuGenerator());
+  return subject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGeneratorTest::setUp()
+{
+  subject_ = createSubject();
+}
+
+} // End of namespace sudoku.
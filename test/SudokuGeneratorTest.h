@@ -0,0 +1,78 @@
+#ifndef __sudoku_sudokugeneratortest_h__
+#define __sudoku_sudokugeneratortest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for SudokuGenerator.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/shared_ptr.hpp>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/SudokuGenerator.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuGeneratorTest class for testing SudokuGenerator.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuGeneratorTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SudokuGeneratorTest);
+  CPPUNIT_TEST(testPuzzleHasOneSolution);
+  CPPUNIT_TEST(testNumberOfClues);
+  CPPUNIT_TEST(testMinimalPuzzle);
+  CPPUNIT_TEST(testSameSeedGivesSamePuzzle);
+  CPPUNIT_TEST(testSymmetry);
+  CPPUNIT_TEST(testManyPuzzlesIndependentOfThreads);
+  CPPUNIT_TEST(testPuzzlesWithTooManyCluesCounted);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    //void tearDown();
+
+    /// \test Test a puzzle made has exactly one solution.
+    void testPuzzleHasOneSolution();
+
+    /// \test Test puzzles made have the number of values asked for.
+    void testNumberOfClues();
+
+    /// \test Test no value can be taken out of a puzzle made with as few values as possible.
+    void testMinimalPuzzle();
+
+    /// \test Test the same seed gives the same puzzle, and different seeds different puzzles.
+    void testSameSeedGivesSamePuzzle();
+
+    /// \test Test the grid points with values have each symmetry.
+    void testSymmetry();
+
+    /// \test Test many puzzles are the same whatever the number of threads or parts they are made
+    /// in, the first is the one made for the seed on its own, and the numbers of values are given.
+    void testManyPuzzlesIndependentOfThreads();
+
+    /// \test Test the puzzles that could not be brought down to the number of values are counted.
+    void testPuzzlesWithTooManyCluesCounted();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<SudokuGenerator> subject_; // subject used for testing.
+    SudokuBitBoard solver_; // Used to check the puzzles.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<SudokuGenerator> createSubject(); // Method used to create subject.
+};
+
+} // End of namespace sudoku.
+
+#endif
@@ -466,6 +466,25 @@ void SudokuGridPointTest::testRestorePossibleValueThatWasAddedToGuessedValues()
   CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<short>(possibleValues, returnValues) );
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testRemoveAndRestoreWithoutRecord()
+{
+  boost::shared_ptr<SudokuGridPoint> s = createSubject(std::vector<short> {4, 7});
+
+  // The last value removed is the guess, until a value is restored.
+  s->removePossibleValue(7);
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), s->getValue() );
+  s->removePossibleValue(4);
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(4), s->getValue() );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), s->getNumberOfPossibleValues() );
+
+  s->restorePossibleValue(4);
+  s->restorePossibleValue(7);
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), s->getValue() );
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<short>(std::vector<short> {4, 7},
+    s->getPossibleValues()) );
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 void SudokuGridPointTest::testGetValueWhenOneValuePassedToConstructor()
 {
@@ -718,6 +737,79 @@ void SudokuGridPointTest::testRemoveFromOnePossibleValueButNotSameGridPoint()
   CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), s->getValue() );
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testGetPossibleValuesMask()
+{
+  std::vector<short> possibleValues = {1, 4, 9};
+
+  boost::shared_ptr<SudokuGridPoint> s = createSubject(possibleValues);
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<ValueMask>(0x109), s->getPossibleValuesMask() );
+
+  s->removePossibleValue(testFields_.x, testFields_.y, 4);
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<ValueMask>(0x101), s->getPossibleValuesMask() );
+
+  // A grid point with an initial value has no possible values.
+  CPPUNIT_ASSERT_EQUAL( static_cast<ValueMask>(0), subject_->getPossibleValuesMask() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testGetNumberOfPossibleValues()
+{
+  std::vector<short> possibleValues = {2, 3, 5, 7};
+
+  boost::shared_ptr<SudokuGridPoint> s = createSubject(possibleValues);
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(4), s->getNumberOfPossibleValues() );
+
+  s->removePossibleValue(testFields_.x, testFields_.y, 3);
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(3), s->getNumberOfPossibleValues() );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), subject_->getNumberOfPossibleValues() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testHasPossibleValue()
+{
+  std::vector<short> possibleValues = {2, 9};
+
+  boost::shared_ptr<SudokuGridPoint> s = createSubject(possibleValues);
+
+  CPPUNIT_ASSERT( s->hasPossibleValue(2) );
+  CPPUNIT_ASSERT( s->hasPossibleValue(9) );
+  CPPUNIT_ASSERT( ! s->hasPossibleValue(1) );
+  CPPUNIT_ASSERT( ! s->hasPossibleValue(5) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testWithPossibleValues()
+{
+  std::vector<short> possibleValues = {3, 6, 8};
+
+  SudokuGridPoint s(SudokuGridPoint::withPossibleValues(testFields_.x, testFields_.y,
+    valueToMask(3) | valueToMask(6) | valueToMask(8)));
+
+  CPPUNIT_ASSERT( s.shallowEquals(*createSubject(possibleValues)) );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(0), s.getValue() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuGridPointTest::testExceptionThrownIfPossibleValuesMaskEmpty()
+{
+  try
+  {
+    (void)SudokuGridPoint::withPossibleValues(testFields_.x, testFields_.y, 0);
+
+    // Should not reach here!
+    CPPUNIT_ASSERT(false);
+  }
+  catch ( std::invalid_argument &e )
+  {
+    CPPUNIT_ASSERT( e.what() == std::string("Possible values cannot be empty.") );
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 boost::shared_ptr<SudokuGridPoint> SudokuGridPointTest::createSubject()
 {
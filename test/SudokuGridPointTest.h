@@ -46,6 +46,7 @@ class SudokuGridPointTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testRestorePossibleValueThatIsAlreadyInPossibleValues);
   CPPUNIT_TEST(testRestorePossibleValueWhenInitialValueWasGiven);
   CPPUNIT_TEST(testRestorePossibleValueThatWasAddedToGuessedValues);
+  CPPUNIT_TEST(testRemoveAndRestoreWithoutRecord);
   CPPUNIT_TEST(testGetValueWhenOneValuePassedToConstructor);
   CPPUNIT_TEST(testEqualityOfTwoSudokuGridPointObjects);
   CPPUNIT_TEST(testLessThanOfSudokuGridPointObjects);
@@ -56,6 +57,11 @@ class SudokuGridPointTest : public CppUnit::TestFixture
   CPPUNIT_TEST(testGetAffectedGridPoints);
   CPPUNIT_TEST(testSudokuGridPointsShallowEqualsMethod);
   CPPUNIT_TEST(testRemoveFromOnePossibleValueButNotSameGridPoint);
+  CPPUNIT_TEST(testGetPossibleValuesMask);
+  CPPUNIT_TEST(testGetNumberOfPossibleValues);
+  CPPUNIT_TEST(testHasPossibleValue);
+  CPPUNIT_TEST(testWithPossibleValues);
+  CPPUNIT_TEST(testExceptionThrownIfPossibleValuesMaskEmpty);
   CPPUNIT_TEST_SUITE_END();
   
   //////////////////////////////////////////////////////////////////////////////////////////////////
@@ -142,6 +148,9 @@ class SudokuGridPointTest : public CppUnit::TestFixture
     /// possible values to its original state.
     void testRestorePossibleValueThatWasAddedToGuessedValues();
 
+    /// \test Test removing and restoring possible values for a solver that keeps its own record.
+    void testRemoveAndRestoreWithoutRecord();
+
     /// \test Test that valid value is returned if one value passed to possible values.
     void testGetValueWhenOneValuePassedToConstructor();
   
@@ -173,6 +182,21 @@ class SudokuGridPointTest : public CppUnit::TestFixture
     /// same returns a value of 3.
     void testRemoveFromOnePossibleValueButNotSameGridPoint();
 
+    /// \test Test getting the possible values as a mask, including after removing a value.
+    void testGetPossibleValuesMask();
+
+    /// \test Test getting the number of possible values.
+    void testGetNumberOfPossibleValues();
+
+    /// \test Test checking whether a value is a possible value.
+    void testHasPossibleValue();
+
+    /// \test Test creating a SudokuGridPoint from a mask of possible values.
+    void testWithPossibleValues();
+
+    /// \test Test exception thrown if the mask of possible values is empty.
+    void testExceptionThrownIfPossibleValuesMaskEmpty();
+
   //////////////////////////////////////////////////////////////////////////////////////////////////
   /// Private types and variables.
   //////////////////////////////////////////////////////////////////////////////////////////////////
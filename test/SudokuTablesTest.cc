@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for BasicSudokuTables.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+
+#include "src/SudokuTables.h"
+#include "SudokuTablesTest.h"
+#include "utilities/src/CheckIfVectorsEqual.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::SudokuTablesTest );
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testSizes()
+{
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(9), SudokuTables::boardSize );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(81), SudokuTables::numberOfGridPoints );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(27), SudokuTables::numberOfUnits );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(20), SudokuTables::numberOfPeers );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testPeers()
+{
+  // Peers of (1,2), which is grid point 11.
+  std::vector<int> expected = { 9, 10, 12, 13, 14, 15, 16, 17, 2, 20, 29, 38, 47, 56, 65, 74,
+                                0, 1, 18, 19 };
+
+  const SudokuTables::Index* peers(SudokuTables::getPeers(11));
+  std::vector<int> result(peers, peers + SudokuTables::numberOfPeers);
+
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<int>(expected, result) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testUnits()
+{
+  std::vector<int> expectedRow = { 27, 28, 29, 30, 31, 32, 33, 34, 35 };
+  std::vector<int> expectedColumn = { 4, 13, 22, 31, 40, 49, 58, 67, 76 };
+  std::vector<int> expectedBox = { 57, 58, 59, 66, 67, 68, 75, 76, 77 };
+
+  const SudokuTables::Index* row(SudokuTables::getUnit(3));
+  const SudokuTables::Index* column(SudokuTables::getUnit(9 + 4));
+  const SudokuTables::Index* box(SudokuTables::getUnit(18 + 7));
+
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<int>(expectedRow,
+    std::vector<int>(row, row + 9)) );
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<int>(expectedColumn,
+    std::vector<int>(column, column + 9)) );
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<int>(expectedBox,
+    std::vector<int>(box, box + 9)) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testUnitsOf()
+{
+  // (6,5) is grid point 59, in row 6, column 5 and box 7.
+  const short* units(SudokuTables::getUnitsOf(59));
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(6), units[0] );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(9 + 5), units[1] );
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(18 + 7), units[2] );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testSharesUnit()
+{
+  CPPUNIT_ASSERT( SudokuTables::sharesUnit(0, 0) );
+  CPPUNIT_ASSERT( SudokuTables::sharesUnit(0, 8) );
+  CPPUNIT_ASSERT( SudokuTables::sharesUnit(0, 72) );
+  CPPUNIT_ASSERT( SudokuTables::sharesUnit(0, 20) );
+  CPPUNIT_ASSERT( ! SudokuTables::sharesUnit(0, 21) );
+  CPPUNIT_ASSERT( ! SudokuTables::sharesUnit(40, 80) );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void SudokuTablesTest::testFourByFourPeers()
+{
+  typedef BasicSudokuTables<2> Tables;
+
+  // Peers of (0,0) on a 4x4 board.
+  std::vector<int> expected = { 1, 2, 3, 4, 8, 12, 5 };
+
+  const Tables::Index* peers(Tables::getPeers(0));
+  std::vector<int> result(peers, peers + Tables::numberOfPeers);
+
+  CPPUNIT_ASSERT_EQUAL( static_cast<short>(7), Tables::numberOfPeers );
+  CPPUNIT_ASSERT( utilities::checkIfVectorsEqual<int>(expected, result) );
+}
+
+} // End of namespace sudoku.
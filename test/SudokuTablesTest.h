@@ -0,0 +1,56 @@
+#ifndef __sudoku_sudokutablestest_h__
+#define __sudoku_sudokutablestest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for BasicSudokuTables.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/SudokuTables.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief SudokuTablesTest class for testing BasicSudokuTables.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class SudokuTablesTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(SudokuTablesTest);
+  CPPUNIT_TEST(testSizes);
+  CPPUNIT_TEST(testPeers);
+  CPPUNIT_TEST(testUnits);
+  CPPUNIT_TEST(testUnitsOf);
+  CPPUNIT_TEST(testSharesUnit);
+  CPPUNIT_TEST(testFourByFourPeers);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    /// \test Test the sizes of the tables for a 9x9 board.
+    void testSizes();
+
+    /// \test Test the peers of a grid point are the other grid points in its row, column and box.
+    void testPeers();
+
+    /// \test Test the grid points in a row, a column and a box.
+    void testUnits();
+
+    /// \test Test the units a grid point is in.
+    void testUnitsOf();
+
+    /// \test Test checking if two grid points share a unit.
+    void testSharesUnit();
+
+    /// \test Test the peers of a grid point on a 4x4 board.
+    void testFourByFourPeers();
+};
+
+} // End of namespace sudoku.
+
+#endif
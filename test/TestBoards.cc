@@ -0,0 +1,123 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of the boards shared by the tests.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "src/SudokuTables.h"
+#include "TestBoards.h"
+
+namespace sudoku
+{
+namespace testboards
+{
+
+const short testBoard[81] =
+{
+0, 0, 9, 0, 0, 0, 0, 0, 3,
+0, 3, 0, 0, 5, 7, 0, 0, 0,
+0, 0, 0, 8, 0, 0, 0, 0, 4,
+2, 0, 0, 0, 0, 0, 1, 6, 0,
+0, 5, 0, 1, 7, 6, 0, 0, 0,
+0, 0, 0, 0, 0, 9, 0, 5, 0,
+0, 0, 0, 0, 0, 0, 0, 0, 0,
+8, 6, 0, 4, 1, 0, 0, 0, 9,
+0, 0, 2, 5, 0, 3, 4, 0, 0
+};
+
+const short testBoardSolution[81] =
+{
+1, 8, 9, 6, 2, 4, 5, 7, 3,
+4, 3, 6, 9, 5, 7, 8, 2, 1,
+5, 2, 7, 8, 3, 1, 6, 9, 4,
+2, 9, 4, 3, 8, 5, 1, 6, 7,
+3, 5, 8, 1, 7, 6, 9, 4, 2,
+6, 7, 1, 2, 4, 9, 3, 5, 8,
+9, 4, 3, 7, 6, 8, 2, 1, 5,
+8, 6, 5, 4, 1, 2, 7, 3, 9,
+7, 1, 2, 5, 9, 3, 4, 8, 6
+};
+
+const short alEscargot[81] =
+{
+1, 0, 0, 0, 0, 7, 0, 9, 0,
+0, 3, 0, 0, 2, 0, 0, 0, 8,
+0, 0, 9, 6, 0, 0, 5, 0, 0,
+0, 0, 5, 3, 0, 0, 9, 0, 0,
+0, 1, 0, 0, 8, 0, 0, 0, 2,
+6, 0, 0, 0, 0, 4, 0, 0, 0,
+3, 0, 0, 0, 0, 0, 0, 1, 0,
+0, 4, 1, 0, 0, 0, 0, 0, 7,
+0, 0, 7, 0, 0, 0, 3, 0, 0
+};
+
+const short alEscargotSolution[81] =
+{
+1, 6, 2, 8, 5, 7, 4, 9, 3,
+5, 3, 4, 1, 2, 9, 6, 7, 8,
+7, 8, 9, 6, 4, 3, 5, 2, 1,
+4, 7, 5, 3, 1, 2, 9, 8, 6,
+9, 1, 3, 5, 8, 6, 7, 4, 2,
+6, 2, 8, 7, 9, 4, 1, 3, 5,
+3, 5, 6, 4, 7, 8, 2, 1, 9,
+2, 4, 1, 9, 3, 5, 8, 6, 7,
+8, 9, 7, 2, 6, 1, 3, 5, 4
+};
+
+const short nonSolvableTestBoard[81] =
+{
+6, 2, 8, 5, 0, 0, 0, 0, 3,
+9, 0, 0, 0, 0, 1, 6, 0, 0,
+0, 0, 0, 0, 6, 0, 0, 7, 0,
+7, 0, 0, 4, 0, 0, 0, 1, 0,
+0, 0, 4, 0, 0, 0, 8, 0, 0,
+0, 8, 0, 0, 0, 9, 0, 0, 5,
+0, 1, 0, 0, 4, 0, 0, 0, 0,
+0, 0, 5, 7, 0, 0, 0, 0, 9,
+4, 0, 0, 0, 0, 3, 0, 2, 0
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool checkSolution( const short (&board)[81], const short (&solution)[81] )
+{
+  bool result(true);
+
+  for ( short i(0); i < 81; ++i )
+  {
+    if ( solution[i] < 1 || solution[i] > 9 || ( board[i] != 0 && board[i] != solution[i] ) )
+    {
+      result = false;
+    }
+  }
+
+  for ( short unit(0); unit < SudokuTables::numberOfUnits; ++unit )
+  {
+    bool seen[10] = { false };
+    for ( short i(0); i < 9 && result; ++i )
+    {
+      const short value(solution[SudokuTables::getUnit(unit)[i]]);
+      result = ! seen[value];
+      seen[value] = true;
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string toText( const short (&board)[81], char noValue )
+{
+  std::string text(81, noValue);
+
+  for ( short i(0); i < 81; ++i )
+  {
+    if ( board[i] != 0 )
+    {
+      text[i] = static_cast<char>('0' + board[i]);
+    }
+  }
+
+  return text;
+}
+
+} // End of namespace testboards.
+} // End of namespace sudoku.
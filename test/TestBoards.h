@@ -0,0 +1,51 @@
+#ifndef __sudoku_testboards_h__
+#define __sudoku_testboards_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of the boards shared by the tests.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+namespace sudoku
+{
+namespace testboards
+{
+
+// A test board, row by row.
+extern const short testBoard[81];
+
+// The only solution to the test board.
+extern const short testBoardSolution[81];
+
+// The Al Escargot.
+extern const short alEscargot[81];
+
+// The only solution to the Al Escargot.
+extern const short alEscargotSolution[81];
+
+// A board that is valid, but has no solution.
+extern const short nonSolvableTestBoard[81];
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Checks a solution is complete, keeps the values of the board and has no value twice in
+/// a row, column or box.
+/// \param board The board that was solved.
+/// \param solution The solution.
+/// \return true if the solution is valid, false otherwise.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+bool checkSolution( const short (&board)[81], const short (&solution)[81] );
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Writes a board as a line of 81 characters, as read by PuzzleFile and BatchSolver.
+/// \param board The board.
+/// \param noValue The character for a grid point with no value.
+/// \return The line.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+std::string toText( const short (&board)[81], char noValue = '.' );
+
+} // End of namespace testboards.
+} // End of namespace sudoku.
+
+#endif
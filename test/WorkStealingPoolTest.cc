@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Implementation of tests for WorkStealingPool.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include "src/WorkStealingPool.h"
+#include "WorkStealingPoolTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION( sudoku::WorkStealingPoolTest );
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testNumberOfWorkers()
+{
+  CPPUNIT_ASSERT_EQUAL( 4u, subject_->getNumberOfWorkers() );
+  CPPUNIT_ASSERT( WorkStealingPool().getNumberOfWorkers() > 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testEveryTaskRunOnce()
+{
+  const std::size_t numberOfTasks(10000);
+
+  for ( short run(0); run < 2; ++run )
+  {
+    std::vector<std::atomic<int> > counts(numberOfTasks);
+    for ( auto &count : counts )
+    {
+      count = 0;
+    }
+
+    subject_->run(numberOfTasks, [&counts]( unsigned int, std::size_t task ) { ++counts[task]; });
+
+    bool result(true);
+    for ( auto &count : counts )
+    {
+      if ( count != 1 )
+      {
+        result = false;
+      }
+    }
+    CPPUNIT_ASSERT( result );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testNoTasks()
+{
+  std::atomic<int> calls(0);
+
+  subject_->run(0, [&calls]( unsigned int, std::size_t ) { ++calls; });
+
+  CPPUNIT_ASSERT_EQUAL( 0, calls.load() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testFewerTasksThanWorkers()
+{
+  std::atomic<int> calls(0);
+
+  subject_->run(2, [&calls]( unsigned int, std::size_t ) { ++calls; });
+
+  CPPUNIT_ASSERT_EQUAL( 2, calls.load() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testSlowTasksAreStolen()
+{
+  // Task 0 blocks the worker running it until every other task has run, so that worker's share
+  // must be stolen.
+  const std::size_t numberOfTasks(100);
+  std::atomic<std::size_t> finished(0);
+  std::atomic<std::size_t> started(0);
+  std::vector<unsigned int> workers(numberOfTasks);
+  std::vector<std::size_t> order(numberOfTasks);
+
+  subject_->run(numberOfTasks,
+    [&finished, &started, &workers, &order, numberOfTasks]( unsigned int worker,
+      std::size_t task )
+    {
+      workers[task] = worker;
+      order[task] = started++;
+      if ( task == 0 )
+      {
+        while ( finished != numberOfTasks - 1 )
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+      else
+      {
+        ++finished;
+      }
+    });
+
+  CPPUNIT_ASSERT_EQUAL( numberOfTasks - 1, finished.load() );
+  for ( std::size_t task(1); task < numberOfTasks; ++task )
+  {
+    // The worker running task 0 can only have run other tasks before it.
+    CPPUNIT_ASSERT( workers[task] != workers[0] || order[task] < order[0] );
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::testExceptionThrownAfterTasksFinish()
+{
+  std::atomic<int> calls(0);
+  bool thrown(false);
+
+  try
+  {
+    subject_->run(100, [&calls]( unsigned int, std::size_t task )
+      {
+        ++calls;
+        if ( task == 50 )
+        {
+          throw std::runtime_error("Task failed.");
+        }
+      });
+  }
+  catch ( std::runtime_error& )
+  {
+    thrown = true;
+  }
+
+  CPPUNIT_ASSERT( thrown );
+  CPPUNIT_ASSERT_EQUAL( 100, calls.load() );
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+boost::shared_ptr<WorkStealingPool> WorkStealingPoolTest::createSubject()
+{
+  boost::shared_ptr<WorkStealingPool> subject(new WorkStealingPool(4));
+  return subject;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+void WorkStealingPoolTest::setUp()
+{
+  subject_ = createSubject();
+}
+
+} // End of namespace sudoku.
@@ -0,0 +1,72 @@
+#ifndef __sudoku_workstealingpooltest_h__
+#define __sudoku_workstealingpooltest_h__
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief Declaration of tests for WorkStealingPool.
+/// \author anon
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/shared_ptr.hpp>
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "src/WorkStealingPool.h"
+
+namespace sudoku
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+/// \brief WorkStealingPoolTest class for testing WorkStealingPool.
+////////////////////////////////////////////////////////////////////////////////////////////////////
+class WorkStealingPoolTest : public CppUnit::TestFixture
+{
+  CPPUNIT_TEST_SUITE(WorkStealingPoolTest);
+  CPPUNIT_TEST(testNumberOfWorkers);
+  CPPUNIT_TEST(testEveryTaskRunOnce);
+  CPPUNIT_TEST(testNoTasks);
+  CPPUNIT_TEST(testFewerTasksThanWorkers);
+  CPPUNIT_TEST(testSlowTasksAreStolen);
+  CPPUNIT_TEST(testExceptionThrownAfterTasksFinish);
+  CPPUNIT_TEST_SUITE_END();
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Public methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  public:
+    void setUp();
+    //void tearDown();
+
+    /// \test Test the number of workers.
+    void testNumberOfWorkers();
+
+    /// \test Test every task is run exactly once, and the pool can be run again.
+    void testEveryTaskRunOnce();
+
+    /// \test Test running no tasks.
+    void testNoTasks();
+
+    /// \test Test running fewer tasks than there are workers.
+    void testFewerTasksThanWorkers();
+
+    /// \test Test that a worker blocked on a slow task has its other tasks stolen.
+    void testSlowTasksAreStolen();
+
+    /// \test Test an exception from a task is thrown by run after every task has run.
+    void testExceptionThrownAfterTasksFinish();
+
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private types and variables.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<WorkStealingPool> subject_; // subject used for testing.
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  /// Private methods.
+  //////////////////////////////////////////////////////////////////////////////////////////////////
+  private:
+    boost::shared_ptr<WorkStealingPool> createSubject(); // Method used to create subject.
+};
+
+} // End of namespace sudoku.
+
+#endif